@@ -0,0 +1,177 @@
+#ifndef ZEBRA_ABELIAN
+#define ZEBRA_ABELIAN
+
+#include "group.hpp"
+
+namespace zebra
+{
+    namespace
+    {
+        inline uint64_t gcd64(uint64_t a, uint64_t b)
+        {
+            while (b)
+            {
+                auto t = a % b ;
+                a = b ;
+                b = t ;
+            }
+            return a ;
+        }
+
+        // Diagonal of the Smith normal form of the lattice spanned by the
+        // rows together with n Z^k, which is why every entry may be kept
+        // reduced mod n. Row and column operations on the smallest pivot
+        // clear its row and column, each diagonal entry d then stands for
+        // gcd(d, n) Z, and gcd/lcm swaps restore the divisibility chain.
+        inline std::vector<uint64_t> smith_diagonal(std::vector<std::vector<uint64_t>> a, uint64_t n)
+        {
+            auto k = a.size();
+            auto reduce = [n](uint64_t x, uint64_t q, uint64_t y) { return (x + n - (q * y) % n) % n; };
+            std::vector<uint64_t> result(k, n);
+            for (std::size_t t = 0; t < k; ++t)
+            {
+                for (;;)
+                {
+                    std::size_t row = k, column = k ;
+                    for (std::size_t i = t; i < k; ++i)
+                        for (std::size_t j = t; j < k; ++j)
+                            if (a[i][j] != 0u && (row == k || a[i][j] < a[row][column]))
+                            {
+                                row = i ;
+                                column = j ;
+                            }
+                    if (row == k)
+                        break ;
+                    std::swap(a[t], a[row]);
+                    for (auto&& r : a)
+                        std::swap(r[t], r[column]);
+                    bool clear = true ;
+                    for (std::size_t i = t + 1u; i < k; ++i)
+                    {
+                        auto q = a[i][t] / a[t][t];
+                        for (std::size_t j = t; j < k; ++j)
+                            a[i][j] = reduce(a[i][j], q, a[t][j]);
+                        clear = clear && a[i][t] == 0u ;
+                    }
+                    for (std::size_t j = t + 1u; j < k; ++j)
+                    {
+                        auto q = a[t][j] / a[t][t];
+                        for (std::size_t i = t; i < k; ++i)
+                            a[i][j] = reduce(a[i][j], q, a[i][t]);
+                        clear = clear && a[t][j] == 0u ;
+                    }
+                    if (clear)
+                        break ;
+                }
+                result[t] = gcd64(a[t][t], n);
+            }
+            for (std::size_t i = 0; i < k; ++i)
+                for (std::size_t j = i + 1u; j < k; ++j)
+                {
+                    auto g = gcd64(result[i], result[j]);
+                    result[j] = result[i] / g * result[j];
+                    result[i] = g ;
+                }
+            return result ;
+        }
+    }
+
+    // G = Z_d1 x ... x Z_dr with d1 | d2 | ... | dr, all di > 1. Over the
+    // generating set g1..gk, the subgroup H(i-1) generated by the first
+    // i - 1 is enumerated with exponent vectors; mi is the least power of
+    // gi falling back into it, and gi^mi = g^v gives the relation mi ei - v.
+    // The k relations span every relation, their determinant being |G|,
+    // and the Smith normal form of that k x k matrix gives the factors.
+    template <typename T>
+    const std::vector<uint64_t>&
+    AbelianGroup<T>::invariant_factors() const
+    {
+        if (_invariants)
+            return *_invariants ;
+        const auto& generators = this->generating_set();
+        auto k = generators.size();
+        std::vector<std::vector<uint64_t>> exponents(_order), relations ;
+        std::vector<id_type> members(1u, _identity_id);
+        exponents[_identity_id].assign(k, 0u);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            auto g = generators[i];
+            auto size = members.size();
+            uint64_t m = 1u ;
+            auto power = g ;
+            for (; exponents[power].empty(); ++m, power = _op(power, g))
+                for (std::size_t j = 0; j < size; ++j)
+                {
+                    auto x = _op(members[j], power);
+                    exponents[x] = exponents[members[j]];
+                    exponents[x][i] = m ;
+                    members.push_back(x);
+                }
+            std::vector<uint64_t> relation(k, 0u);
+            for (std::size_t j = 0; j < i; ++j)
+                relation[j] = (_order - exponents[power][j] % _order) % _order ;
+            relation[i] = m % _order ;
+            relations.push_back(std::move(relation));
+        }
+        std::vector<uint64_t> result ;
+        for (auto&& d : smith_diagonal(std::move(relations), _order))
+            if (d > 1u)
+                result.push_back(d);
+        _invariants = std::make_shared<const std::vector<uint64_t>>(std::move(result));
+        return *_invariants ;
+    }
+
+    // The prime powers of every invariant factor, ascending
+    template <typename T>
+    std::vector<uint64_t>
+    AbelianGroup<T>::primary_decomposition() const
+    {
+        std::vector<uint64_t> result ;
+        for (auto&& d : invariant_factors())
+            for (auto&& p : prime_divisors(d))
+            {
+                uint64_t q = 1u ;
+                for (auto m = d; m % p == 0u; m /= p)
+                    q *= p ;
+                result.push_back(q);
+            }
+        std::sort(result.begin(), result.end());
+        return result ;
+    }
+
+    // Every subgroup of an abelian group is normal. A factor is a subgroup
+    // once its embedding respects the products x g for g in a generating
+    // set, every element being a word in the generators, which costs
+    // O(|K| log |K|) rather than the |K|^2 of subgroup().
+    template <typename T>
+    bool
+    AbelianGroup<T>::direct_sum(const Group<T>& lhs, const Group<T>& rhs) const
+    {
+        if (static_cast<uint64_t>(lhs.order()) * rhs.order() != _order)
+            return false;
+        auto embedded = [this](const Group<T>& factor, std::vector<id_type>& embed) {
+            embed = this->_embed(factor);
+            if (std::find(embed.cbegin(), embed.cend(), npos) != embed.cend())
+                return false;
+            auto n = static_cast<id_type>(factor.order());
+            const auto& cells = factor.cells();
+            for (auto&& g : factor.generating_set())
+                for (id_type x = 0; x < n; ++x)
+                    if (embed[cells[static_cast<std::size_t>(x) * n + g]] != this->_op(embed[x], embed[g]))
+                        return false;
+            return true ;
+        };
+        std::vector<id_type> left, right ;
+        if (!embedded(lhs, left) || !embedded(rhs, right))
+            return false;
+        std::vector<bool> member(_order, false);
+        for (auto&& x : left)
+            member[x] = true ;
+        for (auto&& y : right)
+            if (member[y] && y != _identity_id)
+                return false;
+        return true ;
+    }
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef ZEBRA_AUTOMORPHISM
+#define ZEBRA_AUTOMORPHISM
+
+#include "permutation.hpp"
+
+namespace zebra
+{
+    namespace
+    {
+        // Automorphisms by individualisation and refinement. The first path
+        // individualises the smallest element of the first non singleton
+        // colour at every depth, which gives the base and the first leaf.
+        // Going back up the path, every other element v of the cell at
+        // depth k is tried unless the automorphisms found so far, all of
+        // which fix the base points above k, already carry the base point
+        // onto v; trying v means searching its subtree for one leaf that
+        // relabels the first into an automorphism. Nodes whose cell sizes
+        // leave those of the first path at the same depth are cut. The
+        // automorphisms found form a strong generating set for the base.
+        class AutomorphismSearch : public CanonicalForm
+        {
+        public:
+            AutomorphismSearch(const cells_type& cells, id_type order)
+                : CanonicalForm{cells, order, false}
+            {}
+
+            std::vector<Permutation> generators(std::vector<id_type>&);
+
+        protected:
+
+            std::vector<id_type> _sizes(const std::vector<id_type>&) const ;
+            bool                 _match(std::vector<id_type>, std::size_t);
+            bool                 _accept(const std::vector<id_type>&);
+            std::vector<bool>    _orbit(id_type) const ;
+
+            std::vector<std::vector<id_type>> _path ;
+            std::vector<std::vector<id_type>> _profile ;
+            std::vector<id_type>              _first ;
+            std::vector<Permutation>          _generators ;
+        };
+
+        inline std::vector<id_type>
+        AutomorphismSearch::_sizes(const std::vector<id_type>& colours) const
+        {
+            std::vector<id_type> result(_order, 0);
+            for (auto&& c : colours)
+                ++result[c];
+            return result ;
+        }
+
+        inline std::vector<Permutation>
+        AutomorphismSearch::generators(std::vector<id_type>& base)
+        {
+            auto colours = _colours();
+            for (;;)
+            {
+                _refine(colours);
+                _path.push_back(colours);
+                _profile.push_back(_sizes(colours));
+                auto target = _target(colours);
+                if (target == npos)
+                    break ;
+                auto v = static_cast<id_type>(std::find(colours.begin(), colours.end(), target) - colours.begin());
+                base.push_back(v);
+                colours = _individualise(colours, v);
+            }
+            _first = colours ;
+
+            for (std::size_t k = base.size(); k-- > 0; )
+            {
+                const auto& node = _path[k];
+                auto orbit = _orbit(base[k]);
+                for (id_type v = 0; v < _order; ++v)
+                    if (node[v] == node[base[k]] && !orbit[v] && _match(_individualise(node, v), k + 1u))
+                        orbit = _orbit(base[k]);
+            }
+            return _generators ;
+        }
+
+        inline std::vector<bool>
+        AutomorphismSearch::_orbit(id_type point) const
+        {
+            std::vector<bool> result(_order, false);
+            std::vector<id_type> queue(1u, point);
+            result[point] = true ;
+            for (std::size_t i = 0; i < queue.size(); ++i)
+                for (auto&& g : _generators)
+                    if (!result[g[queue[i]]])
+                    {
+                        result[g[queue[i]]] = true ;
+                        queue.push_back(g[queue[i]]);
+                    }
+            return result ;
+        }
+
+        inline bool
+        AutomorphismSearch::_match(std::vector<id_type> colours, std::size_t depth)
+        {
+            _refine(colours);
+            if (_sizes(colours) != _profile[depth])
+                return false ;
+            auto target = _target(colours);
+            if (target == npos)
+                return _accept(colours);
+            for (id_type v = 0; v < _order; ++v)
+                if (colours[v] == target && _match(_individualise(colours, v), depth + 1u))
+                    return true ;
+            return false ;
+        }
+
+        // The element labelled i in the first leaf goes to the one labelled
+        // i here, kept when it preserves the table
+        inline bool
+        AutomorphismSearch::_accept(const std::vector<id_type>& labelling)
+        {
+            std::vector<id_type> inverse(_order), images(_order);
+            for (id_type x = 0; x < _order; ++x)
+                inverse[labelling[x]] = x ;
+            for (id_type x = 0; x < _order; ++x)
+                images[x] = inverse[_first[x]];
+            for (id_type x = 0; x < _order; ++x)
+                for (id_type y = 0; y < _order; ++y)
+                {
+                    auto z = _op(x, y), w = _op(images[x], images[y]);
+                    if (z == npos ? w != npos : w != images[z])
+                        return false ;
+                }
+            _generators.push_back(Permutation(std::move(images)));
+            return true ;
+        }
+    }
+
+    // The automorphisms as permutations of the element ids, with the base
+    // of the search as the base of the stabiliser chain
+    template <typename T>
+    PermutationGroup
+    Magma<T>::automorphisms() const
+    {
+        std::vector<id_type> base ;
+        auto generators = AutomorphismSearch{this->cells(), _order}.generators(base);
+        return PermutationGroup{_order, generators, base};
+    }
+}
+
+#endif
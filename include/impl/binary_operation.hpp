@@ -2,131 +2,199 @@
 #define ZEBRA_BINARY_OP
 
 #include "utils.hpp"
+#include "intern.hpp"
+#include "cow.hpp"
+#include "canonical.hpp"
 
 namespace zebra
 {
+    // The operation is stored as a dense n x n table of interned ids, the
+    // value-keyed table_type is only accepted as input at construction.
+    // Both the interner and the table are shared between copies, so copies
+    // and views of a structure cost O(1) and never hold foreign iterators.
     template <typename T>
     class PartialOperation
     {
     public:
-        
+
         typedef typename Set<T>::const_iterator         titer ;
         typedef Pair<titer, titer>                      param_type;
         typedef HashMap<param_type, titer>              table_type;
         typedef typename table_type::const_iterator     iter ;
-        
+        typedef std::vector<id_type>                    cells_type;
+
         PartialOperation() {}
         PartialOperation(const table_type&, const Set<T>&);
         PartialOperation(iter, iter, const Set<T>&);
-        
+        PartialOperation(const cells_type&, const SharedInterner<T>&);
+
         T     operator()(T, T) const ;
-        T     at(T x, T y) const { return *_table.at(param_type(_itr(x), _itr(y))); }
-        iter  cbegin() const { return _table.cbegin(); }
-        iter  cend() const { return _table.cend(); }
-        bool  exists(T x, T y) const { return _table.count(param_type(_itr(x), _itr(y))) > 0; }
-        
+        T     at(T x, T y) const { return _value(_op(_id(x), _id(y))); }
+        bool  exists(T x, T y) const ;
+
+        std::size_t              size() const { return _order; }
+        bool                     contains(const T& val) const { return _symbols && _symbols->contains(val); }
+        Set<T>                   elements() const { return Set<T>(_symbols->cbegin(), _symbols->cbegin() + _order); }
+        const Interner<T>&       symbols() const { return *_symbols; }
+        const SharedInterner<T>& shared_symbols() const { return _symbols; }
+        const cells_type&        cells() const { return *_cells; }
+        CanonicalForm            canonical() const { return CanonicalForm{*_cells, _order}; }
+        Fingerprint              fingerprint() const { return canonical().fingerprint(); }
+
     protected:
-        
-        titer      _itr(const T& val) const { return _set.find(val); }
-         
-        Set<T>     _set;
-        table_type _table;
-        
+
+        id_type    _id(const T& val) const { return _symbols->id(val); }
+        const T&   _value(id_type id) const { return (*_symbols)[id]; }
+        id_type    _op(id_type x, id_type y) const { return (*_cells)[static_cast<std::size_t>(x) * _order + y]; }
+        void       _fill(const Set<T>&, iter, iter);
+
+        SharedInterner<T> _symbols;
+        Cow<cells_type>   _cells;
+        id_type           _order = 0;
+
     };
-    
+
+    // Keys of the input table are dereferenced here and never stored
+    template <typename T>
+    void
+    PartialOperation<T>::_fill(const Set<T>& set, iter start, iter end)
+    {
+        _symbols = make_interner(set);
+        _order = static_cast<id_type>(set.size());
+        cells_type cells(static_cast<std::size_t>(_order) * _order, npos);
+        for (; start != end; ++start)
+            cells[static_cast<std::size_t>(_id(*start->first.first)) * _order + _id(*start->first.second)] = _id(*start->second);
+        _cells = std::move(cells);
+    }
+
     template <typename T>
     PartialOperation<T>::PartialOperation(const table_type& table, const Set<T>& set)
-        : _table{table}, _set{set}
-    {}
-    
+    {
+        _fill(set, table.cbegin(), table.cend());
+    }
+
     template <typename T>
     PartialOperation<T>::PartialOperation(iter start, iter end, const Set<T>& set)
-        : _set{set}
     {
-        _table = table_type(start, end);
+        _fill(set, start, end);
     }
-    
+
+    template <typename T>
+    PartialOperation<T>::PartialOperation(const cells_type& cells, const SharedInterner<T>& symbols)
+        : _symbols{symbols}, _cells{cells}
+    {
+        _order = static_cast<id_type>(symbols->size());
+        if (_cells->size() != static_cast<std::size_t>(_order) * _order)
+            throw Exception(NOT_CONFORMANT, "Table size does not match the number of symbols...");
+        for (auto&& cell : *_cells)
+            if (cell != npos && cell >= _order)
+                throw Exception(NOT_CONFORMANT, "Table refers to an unknown symbol...");
+    }
+
+    template <typename T>
+    bool
+    PartialOperation<T>::exists(T x, T y) const
+    {
+        auto first = _symbols->find(x), second = _symbols->find(y);
+        return first != npos && second != npos && _op(first, second) != npos ;
+    }
+
     template <typename T>
     T
     PartialOperation<T>::operator()(T first, T second) const
     {
-        if (_set.find(first) == _set.cend() || _set.find(second) == _set.cend())
+        auto x = _symbols->find(first), y = _symbols->find(second);
+        if (x == npos || y == npos)
             throw Exception(DOES_NOT_EXIST, "Parameters not in codomain...");
-        if (!exists(first, second))
+        if (_op(x, y) == npos)
             throw Exception(DOES_NOT_EXIST, "No result exists...");
-        return at(first, second);
+        return _value(_op(x, y));
     }
-    
+
     template <typename T> using PartialMagma = PartialOperation<T> ;
     template <typename T> using PartialGroupoid = PartialOperation<T> ;
-    
+
     template <typename T>
     class BinaryOperation : public PartialOperation<T>
     {
     public:
         typedef typename std::conditional<
-            std::is_arithmetic<T>::value, 
-            std::function<T(T, T)>, 
+            std::is_arithmetic<T>::value,
+            std::function<T(T, T)>,
             std::function<T(const T&, const T&)>>::type bin_op_type;
         using typename PartialOperation<T>::titer ;
         using typename PartialOperation<T>::param_type;
         using typename PartialOperation<T>::table_type;
         using typename PartialOperation<T>::iter ;
-        
+        using typename PartialOperation<T>::cells_type;
+
         BinaryOperation() {}
         BinaryOperation(const table_type&, const Set<T>&);
         BinaryOperation(iter, iter, const Set<T>&);
         BinaryOperation(bin_op_type&&, const Set<T>&);
-        
+        BinaryOperation(const cells_type&, const SharedInterner<T>&);
+
     protected:
-    
-        using PartialOperation<T>::_set ;
-        using PartialOperation<T>::_table ;
-        using PartialOperation<T>::_itr ;
-        
+
+        using PartialOperation<T>::_symbols ;
+        using PartialOperation<T>::_cells ;
+        using PartialOperation<T>::_order ;
+        using PartialOperation<T>::_id ;
+        using PartialOperation<T>::_value ;
+        using PartialOperation<T>::_op ;
+
         void check() throw(Exception);
-        
+
     };
-    
+
     template <typename T>
     void
     BinaryOperation<T>::check() throw(Exception)
     {
-        auto pairs = make_pairs(_set, _set);
-        for (auto&& pair : pairs)
-            if (_table.count(pair) == 0)
+        for (auto&& cell : *_cells)
+            if (cell == npos)
                 throw Exception(NOT_CONFORMANT, "Given function is partial in nature...");
     }
-    
+
     template <typename T>
     BinaryOperation<T>::BinaryOperation(const table_type& table, const Set<T>& set)
         : PartialOperation<T>{table, set}
     {
         check();
     }
-    
+
     template <typename T>
     BinaryOperation<T>::BinaryOperation(iter start, iter end, const Set<T>& set)
         : PartialOperation<T>{start, end, set}
     {
         check();
     }
-    
+
+    template <typename T>
+    BinaryOperation<T>::BinaryOperation(const cells_type& cells, const SharedInterner<T>& symbols)
+        : PartialOperation<T>{cells, symbols}
+    {
+        check();
+    }
+
     template <typename T>
     BinaryOperation<T>::BinaryOperation(bin_op_type&& func, const Set<T>& set)
         : PartialOperation<T>{}
     {
-        _set = set ;
-        auto pairs = make_pairs(_set, _set);
-        for (auto&& pair : pairs)
-        {
-            auto result = func(pair.first, pair.second);
-            if (_set.find(result) == _set.cend())
-                throw Exception(NOT_CONFORMANT, "Given function is not closed...");
-             _table[param_type(_itr(pair.first), _itr(pair.second))] = _itr(result);
-        }
+        _symbols = make_interner(set);
+        _order = static_cast<id_type>(set.size());
+        cells_type cells(static_cast<std::size_t>(_order) * _order, npos);
+        for (id_type x = 0; x < _order; ++x)
+            for (id_type y = 0; y < _order; ++y)
+            {
+                auto result = _symbols->find(func(_value(x), _value(y)));
+                if (result == npos)
+                    throw Exception(NOT_CONFORMANT, "Given function is not closed...");
+                cells[static_cast<std::size_t>(x) * _order + y] = result ;
+            }
+        _cells = std::move(cells);
     }
-    
+
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,201 @@
+#ifndef ZEBRA_BITSET
+#define ZEBRA_BITSET
+
+#include "includes.hpp"
+
+namespace zebra
+{
+    // Dense membership over ids [0, size()), one bit per id
+    class Bitset
+    {
+    public:
+
+        typedef uint64_t word_type ;
+        static const std::size_t word_bits = 64u ;
+
+        Bitset() {}
+        explicit Bitset(std::size_t bits, bool value = false)
+            : _bits{bits}, _words((bits + word_bits - 1) / word_bits, value ? ~word_type(0) : word_type(0))
+        { _trim(); }
+
+        std::size_t size() const { return _bits; }
+        bool        test(std::size_t pos) const { return (_words[pos / word_bits] >> (pos % word_bits)) & 1u; }
+        bool        operator[](std::size_t pos) const { return test(pos); }
+        void        set(std::size_t pos) { _words[pos / word_bits] |= word_type(1) << (pos % word_bits); }
+        void        reset(std::size_t pos) { _words[pos / word_bits] &= ~(word_type(1) << (pos % word_bits)); }
+        void        set(std::size_t pos, bool value) { value ? set(pos) : reset(pos); }
+        void        clear() { std::fill(_words.begin(), _words.end(), word_type(0)); }
+        void        resize(std::size_t bits) { _bits = bits; _words.resize((bits + word_bits - 1) / word_bits, 0u); _trim(); }
+
+        std::size_t count() const ;
+        std::size_t next(std::size_t) const ;
+        bool        any() const ;
+        bool        none() const { return !any(); }
+        bool        subset_of(const Bitset&) const ;
+        bool        intersects(const Bitset&) const ;
+        std::size_t hash() const ;
+
+        template <typename F> void each(F&&) const ;
+
+        Bitset& operator|=(const Bitset&);
+        Bitset& operator&=(const Bitset&);
+        Bitset& operator-=(const Bitset&);
+
+        bool operator==(const Bitset& rhs) const { return _bits == rhs._bits && _words == rhs._words; }
+        bool operator!=(const Bitset& rhs) const { return !(*this == rhs); }
+
+        const std::vector<word_type>& words() const { return _words; }
+
+        static std::size_t popcount(word_type);
+        static std::size_t lowest(word_type);
+
+    protected:
+
+        void _trim()
+        {
+            if (_bits % word_bits != 0u && !_words.empty())
+                _words.back() &= (word_type(1) << (_bits % word_bits)) - 1u;
+        }
+
+        std::size_t            _bits = 0u ;
+        std::vector<word_type> _words ;
+    };
+
+    inline std::size_t
+    Bitset::popcount(word_type word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+        std::size_t count = 0u ;
+        for (; word; word &= word - 1u)
+            ++count ;
+        return count ;
+#endif
+    }
+
+    inline std::size_t
+    Bitset::lowest(word_type word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+        std::size_t pos = 0u ;
+        for (; !(word & 1u); word >>= 1)
+            ++pos ;
+        return pos ;
+#endif
+    }
+
+    inline std::size_t
+    Bitset::count() const
+    {
+        std::size_t result = 0u ;
+        for (auto&& word : _words)
+            result += popcount(word);
+        return result ;
+    }
+
+    // First set bit at or after pos, size() when there is none
+    inline std::size_t
+    Bitset::next(std::size_t pos) const
+    {
+        if (pos >= _bits)
+            return _bits ;
+        std::size_t index = pos / word_bits ;
+        word_type word = _words[index] & (~word_type(0) << (pos % word_bits));
+        while (!word)
+        {
+            if (++index == _words.size())
+                return _bits ;
+            word = _words[index];
+        }
+        return index * word_bits + lowest(word);
+    }
+
+    inline bool
+    Bitset::any() const
+    {
+        for (auto&& word : _words)
+            if (word)
+                return true ;
+        return false ;
+    }
+
+    inline bool
+    Bitset::subset_of(const Bitset& rhs) const
+    {
+        for (std::size_t i = 0; i < _words.size(); ++i)
+            if (_words[i] & ~(i < rhs._words.size() ? rhs._words[i] : word_type(0)))
+                return false ;
+        return true ;
+    }
+
+    inline bool
+    Bitset::intersects(const Bitset& rhs) const
+    {
+        for (std::size_t i = 0; i < std::min(_words.size(), rhs._words.size()); ++i)
+            if (_words[i] & rhs._words[i])
+                return true ;
+        return false ;
+    }
+
+    inline std::size_t
+    Bitset::hash() const
+    {
+        std::size_t result = _bits ;
+        for (auto&& word : _words)
+            result ^= std::hash<word_type>()(word) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+        return result ;
+    }
+
+    template <typename F>
+    void
+    Bitset::each(F&& function) const
+    {
+        for (std::size_t i = 0; i < _words.size(); ++i)
+            for (word_type word = _words[i]; word; word &= word - 1u)
+                function(i * word_bits + lowest(word));
+    }
+
+    inline Bitset&
+    Bitset::operator|=(const Bitset& rhs)
+    {
+        if (rhs._bits > _bits)
+            resize(rhs._bits);
+        for (std::size_t i = 0; i < rhs._words.size(); ++i)
+            _words[i] |= rhs._words[i];
+        return *this ;
+    }
+
+    inline Bitset&
+    Bitset::operator&=(const Bitset& rhs)
+    {
+        for (std::size_t i = 0; i < _words.size(); ++i)
+            _words[i] &= i < rhs._words.size() ? rhs._words[i] : word_type(0);
+        return *this ;
+    }
+
+    inline Bitset&
+    Bitset::operator-=(const Bitset& rhs)
+    {
+        for (std::size_t i = 0; i < std::min(_words.size(), rhs._words.size()); ++i)
+            _words[i] &= ~rhs._words[i];
+        return *this ;
+    }
+
+    inline Bitset operator|(Bitset lhs, const Bitset& rhs) { return lhs |= rhs; }
+    inline Bitset operator&(Bitset lhs, const Bitset& rhs) { return lhs &= rhs; }
+    inline Bitset operator-(Bitset lhs, const Bitset& rhs) { return lhs -= rhs; }
+}
+
+namespace std
+{
+    template <>
+    struct hash<zebra::Bitset>
+    {
+        size_t operator()(const zebra::Bitset& bits) const { return bits.hash(); }
+    };
+}
+
+#endif
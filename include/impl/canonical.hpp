@@ -0,0 +1,299 @@
+#ifndef ZEBRA_CANONICAL
+#define ZEBRA_CANONICAL
+
+#include "utils.hpp"
+#include "bitset.hpp"
+
+namespace zebra
+{
+    // A 128 bit digest of a canonical table, equal for isomorphic tables
+    struct Fingerprint
+    {
+        uint64_t high = 0 ;
+        uint64_t low = 0 ;
+
+        bool operator==(const Fingerprint& rhs) const { return high == rhs.high && low == rhs.low; }
+        bool operator!=(const Fingerprint& rhs) const { return !(*this == rhs); }
+        bool operator<(const Fingerprint& rhs) const { return high < rhs.high || (high == rhs.high && low < rhs.low); }
+    };
+
+    // Canonical relabelling of a dense n x n table of ids, partial cells
+    // being npos. Elements are first coloured by row and column statistics,
+    // the colouring is refined until every element of a colour sees the
+    // same multiset of (colour of y, colour of xy, colour of yx), and the
+    // search then individualises the elements of the first non singleton
+    // colour in turn, in the manner of nauty. Every discrete colouring
+    // reached is a labelling, and the canonical table is the smallest
+    // relabelled table among them. Two leaves giving the same table differ
+    // by an automorphism, which is kept to skip the children of later
+    // nodes lying in the orbit of one already searched.
+    class CanonicalForm
+    {
+    public:
+        typedef std::vector<id_type> cells_type ;
+
+        CanonicalForm() {}
+        CanonicalForm(const cells_type&, id_type);
+
+        std::size_t                 size() const { return _order; }
+        const std::vector<id_type>& labelling() const { return _labelling; }
+        const cells_type&           cells() const { return _best; }
+        Fingerprint                 fingerprint() const ;
+        std::size_t                 leaves() const { return _leaves; }
+
+    protected:
+
+        CanonicalForm(const cells_type&, id_type, bool);
+
+        id_type              _op(id_type x, id_type y) const { return _cells[static_cast<std::size_t>(x) * _order + y]; }
+        std::vector<id_type> _colours() const ;
+        id_type              _target(const std::vector<id_type>&) const ;
+        std::vector<id_type> _individualise(std::vector<id_type>, id_type) const ;
+        void                 _refine(std::vector<id_type>&) const ;
+        void                 _search(std::vector<id_type>&, std::vector<id_type>&);
+        void                 _leaf(const std::vector<id_type>&);
+        bool                 _pruned(const std::vector<id_type>&, const std::vector<id_type>&, id_type) const ;
+
+        cells_type                        _cells ;
+        id_type                           _order = 0 ;
+        std::vector<id_type>              _labelling ;
+        cells_type                        _best ;
+        std::vector<std::vector<id_type>> _automorphisms ;
+        std::size_t                       _leaves = 0 ;
+    };
+
+    namespace
+    {
+        inline uint64_t mix64(uint64_t x)
+        {
+            x += 0x9e3779b97f4a7c15ull ;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull ;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull ;
+            return x ^ (x >> 31);
+        }
+
+        // Rank coding: every element takes the number of elements whose key
+        // is strictly smaller, so a colour is also the start of its cell
+        template <typename K>
+        std::size_t rank_colours(std::vector<id_type>& colours, const std::vector<K>& keys)
+        {
+            std::vector<id_type> order(colours.size());
+            for (id_type x = 0; x < order.size(); ++x)
+                order[x] = x ;
+            std::sort(order.begin(), order.end(), [&keys](id_type x, id_type y) { return keys[x] < keys[y]; });
+            std::size_t cells = 0 ;
+            for (id_type k = 0; k < order.size(); ++k)
+            {
+                if (k == 0 || keys[order[k - 1]] < keys[order[k]])
+                {
+                    ++cells ;
+                    colours[order[k]] = k ;
+                }
+                else
+                    colours[order[k]] = colours[order[k - 1]];
+            }
+            return cells ;
+        }
+    }
+
+    inline
+    CanonicalForm::CanonicalForm(const cells_type& cells, id_type order)
+        : CanonicalForm{cells, order, true}
+    {}
+
+    inline
+    CanonicalForm::CanonicalForm(const cells_type& cells, id_type order, bool search)
+        : _cells{cells}, _order{order}
+    {
+        if (_cells.size() != static_cast<std::size_t>(order) * order)
+            throw Exception(NOT_CONFORMANT, "Table size does not match the number of symbols...");
+        if (!search)
+            return ;
+        std::vector<id_type> colours = _colours(), prefix ;
+        _search(colours, prefix);
+    }
+
+    // Idempotency, occurrences in the table, distinct entries and
+    // undefined cells of the row and of the column
+    inline std::vector<id_type>
+    CanonicalForm::_colours() const
+    {
+        std::vector<std::vector<uint64_t>> statistics(_order, std::vector<uint64_t>(6, 0));
+        for (id_type x = 0; x < _order; ++x)
+        {
+            statistics[x][0] = _op(x, x) == x ;
+            Bitset row(_order), column(_order);
+            for (id_type y = 0; y < _order; ++y)
+            {
+                auto r = _op(x, y), c = _op(y, x);
+                if (r == npos)
+                    ++statistics[x][4];
+                else
+                {
+                    ++statistics[r][1];
+                    row.set(r);
+                }
+                if (c == npos)
+                    ++statistics[x][5];
+                else
+                    column.set(c);
+            }
+            statistics[x][2] = row.count();
+            statistics[x][3] = column.count();
+        }
+        std::vector<id_type> colours(_order);
+        rank_colours(colours, statistics);
+        return colours ;
+    }
+
+    // Equitable refinement, each round recolouring by the old colour and a
+    // commutative digest of the colours met along the row and the column
+    inline void
+    CanonicalForm::_refine(std::vector<id_type>& colours) const
+    {
+        auto colour = [this, &colours](id_type x) -> uint64_t { return x == npos ? _order : colours[x]; };
+        std::vector<Pair<id_type, uint64_t>> keys(_order);
+        std::size_t cells = Set<id_type>(colours.begin(), colours.end()).size();
+        while (cells < _order)
+        {
+            for (id_type x = 0; x < _order; ++x)
+            {
+                uint64_t digest = 0 ;
+                for (id_type y = 0; y < _order; ++y)
+                    digest += mix64(colour(y) ^ mix64(colour(_op(x, y)) ^ mix64(colour(_op(y, x)) + 1u)));
+                keys[x] = Pair<id_type, uint64_t>(colours[x], digest);
+            }
+            auto refined = rank_colours(colours, keys);
+            if (refined == cells)
+                break ;
+            cells = refined ;
+        }
+    }
+
+    // The first colour holding more than one element, npos when discrete
+    inline id_type
+    CanonicalForm::_target(const std::vector<id_type>& colours) const
+    {
+        std::vector<id_type> size(_order, 0);
+        for (auto&& c : colours)
+            ++size[c];
+        for (id_type c = 0; c < _order; ++c)
+            if (size[c] > 1u)
+                return c ;
+        return npos ;
+    }
+
+    // v keeps the colour of its cell, the rest of the cell moves after it
+    inline std::vector<id_type>
+    CanonicalForm::_individualise(std::vector<id_type> colours, id_type v) const
+    {
+        auto target = colours[v];
+        for (id_type x = 0; x < _order; ++x)
+            if (colours[x] == target && x != v)
+                colours[x] = target + 1u ;
+        return colours ;
+    }
+
+    inline void
+    CanonicalForm::_search(std::vector<id_type>& colours, std::vector<id_type>& prefix)
+    {
+        _refine(colours);
+        auto target = _target(colours);
+        if (target == npos)
+            return _leaf(colours);
+
+        std::vector<id_type> searched ;
+        for (id_type v = 0; v < _order; ++v)
+        {
+            if (colours[v] != target || _pruned(prefix, searched, v))
+                continue ;
+            auto child = _individualise(colours, v);
+            prefix.push_back(v);
+            _search(child, prefix);
+            prefix.pop_back();
+            searched.push_back(v);
+        }
+    }
+
+    inline void
+    CanonicalForm::_leaf(const std::vector<id_type>& labelling)
+    {
+        ++_leaves ;
+        cells_type table(_cells.size());
+        for (id_type x = 0; x < _order; ++x)
+            for (id_type y = 0; y < _order; ++y)
+            {
+                auto z = _op(x, y);
+                table[static_cast<std::size_t>(labelling[x]) * _order + labelling[y]] = z == npos ? npos : labelling[z];
+            }
+        if (_labelling.empty() || table < _best)
+        {
+            _best = std::move(table);
+            _labelling = labelling ;
+        }
+        else if (table == _best)
+        {
+            // x -> the element holding the same canonical label in the best leaf
+            std::vector<id_type> inverse(_order), automorphism(_order);
+            for (id_type x = 0; x < _order; ++x)
+                inverse[_labelling[x]] = x ;
+            for (id_type x = 0; x < _order; ++x)
+                automorphism[x] = inverse[labelling[x]];
+            _automorphisms.push_back(std::move(automorphism));
+        }
+    }
+
+    // v is skipped when an automorphism fixing the prefix pointwise carries
+    // some searched sibling onto it, its subtree then being an image
+    inline bool
+    CanonicalForm::_pruned(const std::vector<id_type>& prefix, const std::vector<id_type>& searched, id_type v) const
+    {
+        if (searched.empty() || _automorphisms.empty())
+            return false ;
+        std::vector<id_type> parent(_order);
+        for (id_type x = 0; x < _order; ++x)
+            parent[x] = x ;
+        std::function<id_type(id_type)> find = [&parent, &find](id_type x) {
+            return parent[x] == x ? x : parent[x] = find(parent[x]);
+        };
+        for (auto&& automorphism : _automorphisms)
+        {
+            bool fixing = true ;
+            for (auto&& p : prefix)
+                fixing = fixing && automorphism[p] == p ;
+            if (!fixing)
+                continue ;
+            for (id_type x = 0; x < _order; ++x)
+                parent[find(x)] = find(automorphism[x]);
+        }
+        for (auto&& u : searched)
+            if (find(u) == find(v))
+                return true ;
+        return false ;
+    }
+
+    inline Fingerprint
+    CanonicalForm::fingerprint() const
+    {
+        Fingerprint result ;
+        result.high = mix64(_order);
+        result.low = mix64(result.high ^ 0x2545f4914f6cdd1dull);
+        for (auto&& cell : _best)
+        {
+            result.high = mix64(result.high ^ cell);
+            result.low = mix64(result.low + cell * 0x9e3779b97f4a7c15ull + 1u);
+        }
+        return result ;
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<zebra::Fingerprint>
+    {
+        size_t operator()(const zebra::Fingerprint& print) const { return print.high ^ print.low; }
+    };
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef ZEBRA_CAYLEY
+#define ZEBRA_CAYLEY
+
+#include "utils.hpp"
+#include "intern.hpp"
+
+namespace zebra
+{
+    // The right Cayley graph of a monoid for a list of generators, edges
+    // x -> x s. Adjacency is a dense n x |gens| array of ids, so walking an
+    // edge is one lookup. A single breadth first search from the identity
+    // gives every word length, and its tree is kept as a predecessor and a
+    // generator per element: x = predecessor(x) s_via(x), a straight line
+    // program shared by all elements, from which word() reads a shortest
+    // word in O(length) without searching again. Elements the generators
+    // do not reach have length npos.
+    template <typename T, template <typename> class Parent>
+    class CayleyGraph
+    {
+    public:
+
+        CayleyGraph() {}
+        CayleyGraph(const Parent<T>&, const std::vector<T>&, id_type);
+
+        const Parent<T>&            parent() const { return _parent; }
+        const std::vector<T>&       generators() const { return _generators; }
+        std::size_t                 degree() const { return _generators.size(); }
+        std::size_t                 size() const { return _size; }
+        const std::vector<id_type>& adjacency() const { return _adjacency; }
+        id_type                     neighbour(id_type x, std::size_t i) const { return _adjacency[static_cast<std::size_t>(x) * degree() + i]; }
+        const std::vector<id_type>& lengths() const { return _length; }
+        id_type                     predecessor(id_type x) const { return _from[x]; }
+        id_type                     via(id_type x) const { return _via[x]; }
+
+        bool                        reachable(const T&) const ;
+        std::size_t                 length(const T& x) const { return _length[_reached(x)]; }
+        std::size_t                 diameter() const { return _growth.size() - 1u; }
+        const std::vector<std::size_t>& growth() const { return _growth; }
+        std::vector<std::size_t>    word(const T& x) const { return word_at(_reached(x)); }
+        std::vector<std::size_t>    word_at(id_type) const ;
+        T                           evaluate(const std::vector<std::size_t>&) const ;
+
+    protected:
+
+        id_type _reached(const T&) const ;
+
+        Parent<T>                _parent ;
+        std::vector<T>           _generators ;
+        id_type                  _identity = npos ;
+        std::size_t              _size = 0u ;
+        std::vector<id_type>     _adjacency ;
+        std::vector<id_type>     _length, _from, _via ;
+        std::vector<std::size_t> _growth ;
+    };
+
+    template <typename T, template <typename> class Parent>
+    CayleyGraph<T, Parent>::CayleyGraph(const Parent<T>& parent, const std::vector<T>& generators, id_type identity)
+        : _parent{parent}, _generators{generators}, _identity{identity}
+    {
+        auto n = static_cast<id_type>(parent.size());
+        auto k = generators.size();
+        const auto& cells = parent.cells();
+        std::vector<id_type> gens ;
+        for (auto&& g : generators)
+        {
+            auto id = parent.symbols().find(g);
+            if (id == npos)
+                throw Exception(NOT_A_MEMBER, "Generator not in the parent structure...");
+            gens.push_back(id);
+        }
+        _adjacency.resize(static_cast<std::size_t>(n) * k);
+        for (id_type x = 0; x < n; ++x)
+            for (std::size_t i = 0; i < k; ++i)
+                _adjacency[static_cast<std::size_t>(x) * k + i] = cells[static_cast<std::size_t>(x) * n + gens[i]];
+
+        _length.assign(n, npos);
+        _from.assign(n, npos);
+        _via.assign(n, npos);
+        std::vector<id_type> queue(1u, identity);
+        _length[identity] = 0u ;
+        for (std::size_t j = 0; j < queue.size(); ++j)
+        {
+            auto x = queue[j];
+            if (_length[x] == _growth.size())
+                _growth.push_back(0u);
+            ++_growth[_length[x]];
+            for (std::size_t i = 0; i < k; ++i)
+            {
+                auto y = neighbour(x, i);
+                if (_length[y] != npos)
+                    continue ;
+                _length[y] = _length[x] + 1u ;
+                _from[y] = x ;
+                _via[y] = static_cast<id_type>(i);
+                queue.push_back(y);
+            }
+        }
+        _size = queue.size();
+    }
+
+    template <typename T, template <typename> class Parent>
+    id_type
+    CayleyGraph<T, Parent>::_reached(const T& value) const
+    {
+        auto id = _parent.symbols().find(value);
+        if (id == npos || _length[id] == npos)
+            throw Exception(NOT_A_MEMBER, "The value is not reached by the generators...");
+        return id ;
+    }
+
+    template <typename T, template <typename> class Parent>
+    bool
+    CayleyGraph<T, Parent>::reachable(const T& value) const
+    {
+        auto id = _parent.symbols().find(value);
+        return id != npos && _length[id] != npos ;
+    }
+
+    // Generator indices read left to right, as long as the word length
+    template <typename T, template <typename> class Parent>
+    std::vector<std::size_t>
+    CayleyGraph<T, Parent>::word_at(id_type id) const
+    {
+        if (id >= _length.size() || _length[id] == npos)
+            throw Exception(NOT_A_MEMBER, "The value is not reached by the generators...");
+        std::vector<std::size_t> result(_length[id]);
+        for (auto k = result.size(); k-- > 0; id = _from[id])
+            result[k] = _via[id];
+        return result ;
+    }
+
+    template <typename T, template <typename> class Parent>
+    T
+    CayleyGraph<T, Parent>::evaluate(const std::vector<std::size_t>& word) const
+    {
+        id_type x = _identity ;
+        for (auto&& i : word)
+        {
+            if (i >= degree())
+                throw Exception(NOT_A_MEMBER, "Generator index out of range...");
+            x = neighbour(x, i);
+        }
+        return _parent.symbols()[x];
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef ZEBRA_CONJUGACY
+#define ZEBRA_CONJUGACY
+
+#include "intern.hpp"
+#include "bitset.hpp"
+
+namespace zebra
+{
+    // Conjugacy in a finite group given by its dense n x n table of ids and
+    // its inverse table. One O(n^2) pass yields the class of every element
+    // and the centraliser of every element as a bitset. The centre is the
+    // union of the singleton classes. A subgroup is normal exactly when it
+    // is a union of classes, which takes O(|H|) to test.
+    class Conjugacy
+    {
+    public:
+
+        Conjugacy() {}
+        Conjugacy(const std::vector<id_type>&, const std::vector<id_type>&);
+
+        std::size_t                 classes() const { return _members.size(); }
+        id_type                     class_of(id_type x) const { return _class[x]; }
+        std::size_t                 class_size(id_type c) const { return _members[c].size(); }
+        id_type                     representative(id_type c) const { return _members[c].front(); }
+        const std::vector<id_type>& members(id_type c) const { return _members[c]; }
+        const Bitset&               centralizer(id_type x) const { return _centralizers[x]; }
+        const Bitset&               center() const { return _center; }
+        bool                        conjugate(id_type x, id_type y) const { return _class[x] == _class[y]; }
+        bool                        normal(const Bitset&) const ;
+
+    protected:
+
+        std::vector<id_type>              _class ;
+        std::vector<std::vector<id_type>> _members ;
+        std::vector<Bitset>               _centralizers ;
+        Bitset                            _center ;
+    };
+
+    inline
+    Conjugacy::Conjugacy(const std::vector<id_type>& cells, const std::vector<id_type>& inverse)
+    {
+        auto order = static_cast<id_type>(inverse.size());
+        auto op = [&cells, order](id_type x, id_type y) { return cells[static_cast<std::size_t>(x) * order + y]; };
+        _class.assign(order, npos);
+        _centralizers.assign(order, Bitset(order));
+        _center = Bitset(order);
+        for (id_type x = 0; x < order; ++x)
+            for (id_type y = 0; y < order; ++y)
+                if (op(x, y) == op(y, x))
+                    _centralizers[x].set(y);
+        // The class of x is {g^-1 x g}, one sweep over g per class
+        for (id_type x = 0; x < order; ++x)
+            if (_class[x] == npos)
+            {
+                auto c = static_cast<id_type>(_members.size());
+                _members.emplace_back();
+                for (id_type g = 0; g < order; ++g)
+                {
+                    auto y = op(op(inverse[g], x), g);
+                    if (_class[y] == npos)
+                    {
+                        _class[y] = c ;
+                        _members.back().push_back(y);
+                    }
+                }
+                if (_members.back().size() == 1u)
+                    _center.set(x);
+            }
+    }
+
+    // A union of classes: the sizes of the classes met add up to |H|
+    inline bool
+    Conjugacy::normal(const Bitset& members) const
+    {
+        std::vector<bool> met(_members.size(), false);
+        std::size_t covered = 0u, size = 0u ;
+        members.each([&](std::size_t h) {
+            ++size ;
+            auto c = _class[h];
+            if (!met[c])
+            {
+                met[c] = true ;
+                covered += _members[c].size();
+            }
+        });
+        return covered == size ;
+    }
+}
+
+#endif
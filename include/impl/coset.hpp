@@ -0,0 +1,191 @@
+#ifndef ZEBRA_COSET
+#define ZEBRA_COSET
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // The left, right and double cosets of a subgroup H of a finite group,
+    // as one coset id per element. Cosets are numbered in order of their
+    // smallest element id, which is also the representative kept in the
+    // transversals. H is first checked to be closed, by growing the
+    // subgroup generated by its elements one generator at a time and
+    // failing as soon as it leaves H, at most log2 |H| generators times
+    // |H| lookups; the partition itself then costs O(|G|). Every query
+    // afterwards is a lookup.
+    template <typename T>
+    class CosetIndex
+    {
+    public:
+
+        CosetIndex() {}
+        CosetIndex(const Group<T>&, const Bitset&);
+
+        const Group<T>&             group() const { return _group; }
+        Subgroup<T>                 subgroup() const { return Subgroup<T>{_group, _members}; }
+        std::size_t                 index() const { return _left_transversal.size(); }
+        bool                        normal() const { return _left == _right; }
+
+        id_type                     left_of(id_type g) const { return _left[g]; }
+        id_type                     right_of(id_type g) const { return _right[g]; }
+        id_type                     double_of(id_type g) const { return _double[g]; }
+        const std::vector<id_type>& left() const { return _left; }
+        const std::vector<id_type>& right() const { return _right; }
+        const std::vector<id_type>& doubles() const { return _double; }
+        const std::vector<id_type>& left_transversal() const { return _left_transversal; }
+        const std::vector<id_type>& right_transversal() const { return _right_transversal; }
+        std::size_t                 double_cosets() const { return _double_transversal.size(); }
+
+        id_type left_coset(const T& g) const { return _left[_group.symbols().id(g)]; }
+        id_type right_coset(const T& g) const { return _right[_group.symbols().id(g)]; }
+        id_type double_coset(const T& g) const { return _double[_group.symbols().id(g)]; }
+        T       left_representative(const T& g) const { return _group.symbols()[_left_transversal[left_coset(g)]]; }
+        T       right_representative(const T& g) const { return _group.symbols()[_right_transversal[right_coset(g)]]; }
+        T       double_representative(const T& g) const { return _group.symbols()[_double_transversal[double_coset(g)]]; }
+        bool    same_left(const T& x, const T& y) const { return left_coset(x) == left_coset(y); }
+        bool    same_right(const T& x, const T& y) const { return right_coset(x) == right_coset(y); }
+        bool    same_double(const T& x, const T& y) const { return double_coset(x) == double_coset(y); }
+
+        Set<T>  left_members(id_type) const ;
+        Set<T>  right_members(id_type) const ;
+
+    protected:
+
+        id_type _op(id_type x, id_type y) const { return _group.cells()[static_cast<std::size_t>(x) * _group.size() + y]; }
+        bool    _closed() const ;
+        void    _partition(std::vector<id_type>&, std::vector<id_type>&, bool);
+
+        Group<T>             _group ;
+        Bitset               _members ;
+        std::vector<id_type> _subgroup ;
+        std::vector<id_type> _left, _right, _double ;
+        std::vector<id_type> _left_transversal, _right_transversal, _double_transversal ;
+    };
+
+    template <typename T>
+    CosetIndex<T>::CosetIndex(const Group<T>& group, const Bitset& members)
+        : _group{group}, _members{members}
+    {
+        auto order = static_cast<id_type>(group.order());
+        auto identity = group.symbols().id(group.identity());
+        if (_members.size() != order || !_members.test(identity))
+            throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
+        _members.each([this](std::size_t h) { this->_subgroup.push_back(static_cast<id_type>(h)); });
+        if (!_closed())
+            throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
+        _partition(_left, _left_transversal, true);
+        _partition(_right, _right_transversal, false);
+
+        // HgH is the union of the left cosets hgH, one per h
+        _double.assign(order, npos);
+        for (id_type g = 0; g < order; ++g)
+            if (_double[g] == npos)
+            {
+                auto c = static_cast<id_type>(_double_transversal.size());
+                _double_transversal.push_back(g);
+                for (auto&& h : _subgroup)
+                {
+                    auto coset = _left[_op(h, g)];
+                    auto start = _left_transversal[coset];
+                    if (_double[start] != npos)
+                        continue ;
+                    for (auto&& k : _subgroup)
+                        _double[_op(start, k)] = c ;
+                }
+            }
+    }
+
+    // Each element of H outside the closure so far joins the generators and
+    // the closure is extended from the elements already reached; H is
+    // closed exactly when no product ever lands outside it
+    template <typename T>
+    bool
+    CosetIndex<T>::_closed() const
+    {
+        auto identity = _group.symbols().id(_group.identity());
+        Bitset closure(_group.size());
+        closure.set(identity);
+        std::vector<id_type> queue(1u, identity), generators ;
+        for (auto&& g : _subgroup)
+        {
+            if (closure.test(g))
+                continue ;
+            generators.push_back(g);
+            for (std::size_t k = 0; k < queue.size(); ++k)
+                for (auto&& s : generators)
+                {
+                    auto y = _op(queue[k], s);
+                    if (closure.test(y))
+                        continue ;
+                    if (!_members.test(y))
+                        return false ;
+                    closure.set(y);
+                    queue.push_back(y);
+                }
+        }
+        return true ;
+    }
+
+    // Labels gH (or Hg) for every g, failing as soon as two translates overlap
+    template <typename T>
+    void
+    CosetIndex<T>::_partition(std::vector<id_type>& cosets, std::vector<id_type>& transversal, bool left)
+    {
+        cosets.assign(_group.size(), npos);
+        for (id_type g = 0; g < cosets.size(); ++g)
+            if (cosets[g] == npos)
+            {
+                auto c = static_cast<id_type>(transversal.size());
+                transversal.push_back(g);
+                for (auto&& h : _subgroup)
+                {
+                    auto x = left ? _op(g, h) : _op(h, g);
+                    if (cosets[x] != npos)
+                        throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
+                    cosets[x] = c ;
+                }
+            }
+    }
+
+    template <typename T>
+    Set<T>
+    CosetIndex<T>::left_members(id_type c) const
+    {
+        Set<T> result ;
+        for (auto&& h : _subgroup)
+            result.insert(_group.symbols()[_op(_left_transversal[c], h)]);
+        return result ;
+    }
+
+    template <typename T>
+    Set<T>
+    CosetIndex<T>::right_members(id_type c) const
+    {
+        Set<T> result ;
+        for (auto&& h : _subgroup)
+            result.insert(_group.symbols()[_op(h, _right_transversal[c])]);
+        return result ;
+    }
+
+    template <typename T>
+    CosetIndex<T>
+    Group<T>::cosets(const Sub<T, Group>& view) const
+    {
+        if (&view.parent().cells() != &this->cells())
+            return cosets(view.elements());
+        return CosetIndex<T>{*this, view.members()};
+    }
+
+    template <typename T>
+    CosetIndex<T>
+    Group<T>::cosets(const Set<T>& set) const
+    {
+        // Closure is left to the index, membership alone is checked here
+        for (auto&& x : set)
+            if (!this->contains(x))
+                throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
+        return CosetIndex<T>{*this, Subgroup<T>{*this, set}.members()};
+    }
+}
+
+#endif
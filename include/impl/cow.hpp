@@ -0,0 +1,44 @@
+#ifndef ZEBRA_COW
+#define ZEBRA_COW
+
+#include "includes.hpp"
+
+namespace zebra
+{
+    // Reference counted storage shared between copies. Reads never copy,
+    // the first write through a shared handle detaches a private copy, so
+    // copying a structure is O(1) and copies never observe each other.
+    template <typename T>
+    class Cow
+    {
+    public:
+
+        Cow() : _data{std::make_shared<T>()} {}
+        Cow(const T& value) : _data{std::make_shared<T>(value)} {}
+        Cow(T&& value) : _data{std::make_shared<T>(std::move(value))} {}
+
+        const T& operator*() const { return *_data; }
+        const T* operator->() const { return _data.get(); }
+        const T& read() const { return *_data; }
+        T&       write();
+
+        long                     use_count() const { return _data.use_count(); }
+        bool                     shares(const Cow<T>& other) const { return _data == other._data; }
+        std::shared_ptr<const T> share() const { return _data; }
+
+    private:
+
+        std::shared_ptr<T> _data ;
+    };
+
+    template <typename T>
+    T&
+    Cow<T>::write()
+    {
+        if (_data.use_count() > 1)
+            _data = std::make_shared<T>(*_data);
+        return *_data ;
+    }
+}
+
+#endif
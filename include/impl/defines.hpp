@@ -1,10 +1,16 @@
 #ifndef ZEBRA_DEFINES
 #define ZEBRA_DEFINES
 
-#define _HOM(X) typename std::enable_if<std::is_same<D, R>::value, X>::type
-#define _NHOM(X) typename std::enable_if<!std::is_same<D, R>::value, X>::type 
-#define _HOM2(X, Y) typename std::enable_if<std::is_same<D, R>::value, X , Y>::type
-#define _HOM3(X, Y, Z) typename std::enable_if<std::is_same<D, R>::value, X , Y , Z>::type
+// Members that only exist on homogenous relations (D == R) are member
+// templates, so that enable_if stays a soft error when D != R. The _DEF
+// forms are for the out-of-class definitions, which repeat no defaults.
+#define _HOM(X) template <typename H = D> typename std::enable_if<std::is_same<H, R>::value, X>::type
+#define _NHOM(X) template <typename H = D> typename std::enable_if<!std::is_same<H, R>::value, X>::type 
+#define _HOM2(X, Y) template <typename H = D> typename std::enable_if<std::is_same<H, R>::value, X , Y>::type
+#define _HOM3(X, Y, Z) template <typename H = D> typename std::enable_if<std::is_same<H, R>::value, X , Y , Z>::type
+#define _HOM_DEF(X) template <typename H> typename std::enable_if<std::is_same<H, R>::value, X>::type
+#define _HOM_DEF2(X, Y) template <typename H> typename std::enable_if<std::is_same<H, R>::value, X , Y>::type
+#define _HOM_DEF3(X, Y, Z) template <typename H> typename std::enable_if<std::is_same<H, R>::value, X , Y , Z>::type
 #define _ISB(X) typename std::enable_if<std::is_arithmetic<T>::value, X>::type
 #define _ISB2(X, Y) typename std::enable_if<std::is_arithmetic<T>::value, X,Y>::type
 #define _ISNB(X) typename std::enable_if<!std::is_arithmetic<T>::value, X>::type 
@@ -12,6 +18,9 @@
 #define NHOM(x) _NHOM(X)
 #define HOM2(X, Y) _HOM2(X, Y)
 #define HOM3(X, Y, Z) _HOM3(X, Y, Z)
+#define HOM_DEF(X) _HOM_DEF(X)
+#define HOM_DEF2(X, Y) _HOM_DEF2(X, Y)
+#define HOM_DEF3(X, Y, Z) _HOM_DEF3(X, Y, Z)
 #define ISB(X) _ISB(X)
 #define ISB2(X, Y) _ISB2(X, Y)
 #define ISNB(X) _ISNB(X)
@@ -2,13 +2,23 @@
 #define ZEBRA_GROUP
 
 #include "monoid.hpp"
+#include "sub.hpp"
+#include "conjugacy.hpp"
 #include <limits>
 
 namespace zebra
 {
-    template <typename A> Error is_group(const Set<A>&, const std::function<A(A, A)>&);
-    template <typename A> Error is_group(const Set<A>&, const HashMap<Pair<A, A>, A>&);
-    template <typename A> Error is_group(const Set<A>&, const Set<Triple<A, A, A>>&);
+    template <typename A> WitnessError<A> is_group(const Interner<A>&, const std::vector<id_type>&);
+    template <typename A, typename F, typename = decltype(std::declval<F&>()(std::declval<const A&>(), std::declval<const A&>()))>
+    WitnessError<A> is_group(const Set<A>&, F&&);
+    template <typename A> WitnessError<A> is_group(const Set<A>&, const HashMap<Pair<A, A>, A>&);
+    template <typename A> WitnessError<A> is_group(const Set<A>&, const Set<Triple<A, A, A>>&);
+    
+    template <typename T> class SubgroupLattice ;
+    template <typename T> class QuotientGroup ;
+    template <typename T> class CosetIndex ;
+    class CosetEnumeration ;
+    template <typename A, typename B> class SemidirectProduct ;
     
     template <typename T>
     class Group : public Monoid<T>
@@ -17,9 +27,8 @@ namespace zebra
         using typename Magma<T>::table_type;
         using typename Magma<T>::bin_op_type;
         using typename Magma<T>::iter;
+        using typename Magma<T>::cells_type;
         typedef typename Magma<T>::param_type key_t;
-        using Monoid<T>::_set;
-        using Monoid<T>::_table;
         using Monoid<T>::at;
         using Monoid<T>::_identity;
         
@@ -27,32 +36,105 @@ namespace zebra
         Group(const table_type&, const Set<T>&);
         Group(iter, iter, const Set<T>&);
         Group(bin_op_type&&, const Set<T>&);
+        Group(const cells_type&, const SharedInterner<T>&);
         
         Set<T>   right_coset(const Set<T>&, const T&) const ;
         Set<T>   right_coset(const Group<T>&, const T&) const ;
         Set<T>   left_coset(const Set<T>&, const T&) const ;
         Set<T>   left_coset(const Group<T>&, const T&) const ;
+        CosetIndex<T> cosets(const Set<T>&) const ;
+        CosetIndex<T> cosets(const Sub<T, Group>&) const ;
+        Closure<T, Group> generate(const std::vector<T>& generators) const { return Closure<T, Group>{*this, generators, _identity_id}; }
+        CayleyGraph<T, Group> cayley_graph(const std::vector<T>& generators) const { return CayleyGraph<T, Group>{*this, generators, _identity_id}; }
+        CayleyGraph<T, Group> cayley_graph() const { return cayley_graph(generators()); }
+        std::vector<T>    generators() const ;
+        const std::vector<id_type>& generating_set() const ;
         bool     subgroup(const Set<T>&) const ;
         bool     subgroup(const Group<T>&) const ;
+        bool     subgroup(const Sub<T, Group>&) const ;
         bool     normal_subgroup(const Set<T>&) const ;
         bool     normal_subgroup(const Group<T>&) const ;
+        bool     normal_subgroup(const Sub<T, Group>&) const ;
         bool     simple() const ;
-        uint64_t order() const { return _set.size(); }
+        SubgroupLattice<T>       lattice() const ;
+        std::vector<Sub<T, Group>> normal_subgroups() const ;
+        std::vector<Sub<T, Group>> maximal_subgroups() const ;
+        uint64_t order() const { return _order; }
         uint64_t order(const T&) const ;
+        uint64_t exponent() const ;
         bool     pgroup(int64_t) const ;
+        bool     cyclic() const ;
+        T        pow(const T& x, int64_t k) const { return _value(_pow(_id(x), k)); }
+        HashMap<uint64_t, std::size_t> order_histogram() const ;
+        const std::vector<id_type>&    orders() const ;
         bool     direct_sum(const Group<T>&, const Group<T>&) const ;
-        Set<Set<T>> quotient(const Group<T>&) const ;
+        QuotientGroup<T> quotient(const Group<T>&) const ;
+        QuotientGroup<T> quotient(const Sub<T, Group>&) const ;
+        Sub<T, Group>    commutator(const Sub<T, Group>&, const Sub<T, Group>&) const ;
+        Sub<T, Group>    derived_subgroup() const ;
+        std::vector<Sub<T, Group>> derived_series() const ;
+        std::vector<Sub<T, Group>> lower_central_series() const ;
+        std::vector<Sub<T, Group>> upper_central_series() const ;
+        bool        solvable() const ;
+        bool        nilpotent() const ;
+        std::size_t derived_length() const ;
+        std::size_t nilpotency_class() const ;
+        Sub<T, Group> normalizer(const Sub<T, Group>&) const ;
+        Sub<T, Group> sylow(int64_t) const ;
+        std::size_t   sylow_count(int64_t) const ;
+        Sub<T, Group> pcore(int64_t) const ;
+        Sub<T, Group> hall(const std::vector<int64_t>&) const ;
+        
+        T        inverse(const T& x) const { return _value(_inv(_id(x))); }
+        T        left_divide(const T& x, const T& y) const { return _value(_op(_inv(_id(x)), _id(y))); }
+        T        right_divide(const T& x, const T& y) const { return _value(_op(_id(x), _inv(_id(y)))); }
+        T        conjugation(const T& x, const T& g) const { return _value(_conj(_id(x), _id(g))); }
+        const std::vector<id_type>& inverses() const { return *_inverse; }
+        
+        const Conjugacy& conjugacy() const ;
+        bool             conjugate(const T&, const T&) const ;
+        Set<T>           conjugacy_class(const T&) const ;
+        Set<Set<T>>      conjugacy_classes() const ;
+        Sub<T, Group>    centralizer(const T&) const ;
+        Sub<T, Group>    center() const ;
         
     protected:
         
+        using Monoid<T>::_symbols;
+        using Monoid<T>::_cells;
+        using Monoid<T>::_order;
+        using Monoid<T>::_op;
+        using Monoid<T>::_id;
+        using Monoid<T>::_value;
+        using Monoid<T>::_identity_id;
+        
+        // Trusted: the table is a group by construction, and its identity
+        // and inverses are already known, so nothing is verified
+        Group(const cells_type&, const SharedInterner<T>&, id_type, const std::vector<id_type>&);
+
         void check();
+        std::vector<id_type> _embed(const Group<T>&) const ;
+        bool _normal(const Bitset&) const ;
+        id_type _inv(id_type x) const { return (*_inverse)[x]; }
+        id_type _conj(id_type x, id_type g) const { return _op(_op(_inv(g), x), g); }
+        id_type _pow(id_type, int64_t) const ;
+        std::vector<id_type> _generators(const Bitset&) const ;
+        Bitset  _normal_closure(std::vector<id_type>, const std::vector<id_type>&) const ;
+        Bitset  _normalizer(const Bitset&, const std::vector<id_type>&) const ;
+        Bitset  _sylow(uint64_t, std::vector<id_type>&) const ;
+        
+        Cow<std::vector<id_type>> _inverse ;
+        mutable std::shared_ptr<const std::vector<id_type>> _orders ;
+        mutable std::shared_ptr<const std::vector<id_type>> _generating ;
         
-        template <typename A> friend Set<Set<A>> operator/(const Group<A>&, const Group<A>&);
-        template <typename A> friend Group<A> operator*(const Group<A>&, const Group<A>&);
-        template <typename A> friend bool is_homomorphism(const Group<A>&, const Group<A>&, const Mapping<A, A>&);
+        // Computed on first use, copies taken afterwards share it
+        mutable std::shared_ptr<const Conjugacy> _conjugacy ;
         
         template <typename G, typename S> friend class GroupAction;
-        template <typename A> friend class GroupHomomorphism; 
+        template <typename> friend class QuotientGroup;
+        friend class CosetEnumeration;
+        friend class PermutationGroup;
+        template <typename, typename> friend class SemidirectProduct;
     };
 
     template <typename T> using Subgroup = Sub<T, Group>;
@@ -78,32 +160,61 @@ namespace zebra
         check();
     }
     
+    template <typename T>
+    Group<T>::Group(const cells_type& cells, const SharedInterner<T>& symbols)
+        : Monoid<T>{cells, symbols}
+    {
+        check();
+    }
+    
+    template <typename T>
+    Group<T>::Group(const cells_type& cells, const SharedInterner<T>& symbols, id_type identity, const std::vector<id_type>& inverse)
+    {
+        _symbols = symbols ;
+        _cells = cells ;
+        _order = static_cast<id_type>(symbols->size());
+        _identity_id = identity ;
+        _identity = _value(identity);
+        _inverse = inverse ;
+    }
+    
     template <typename T>
     void
     Group<T>::check() 
     {
         Monoid<T>::check();
-        for (auto&& x : _set)
+        std::vector<id_type> inverse(_order, npos);
+        for (id_type x = 0; x < _order; ++x)
         {
-            bool flag = false;
-            for (auto&& y : _set)
-                flag = flag || (at(x, y) == _identity && at(y, x) == _identity);
-            if (!flag)
+            for (id_type y = 0; y < _order && inverse[x] == npos; ++y)
+                if (_op(x, y) == _identity_id && _op(y, x) == _identity_id)
+                    inverse[x] = y ;
+            if (inverse[x] == npos)
                 throw Exception(NOT_CONFORMANT, "Not all elements have an inverse...");
         }
+        _inverse = std::move(inverse);
+    }
+    
+    // Ids in this group of the elements of another group, npos if absent
+    template <typename T>
+    std::vector<id_type>
+    Group<T>::_embed(const Group<T>& group) const
+    {
+        return translation(*group._symbols, *_symbols);
     }
 
     template <typename T>
     Set<T>
     Group<T>::right_coset(const Set<T>& set, const T& value) const 
     {
-        if (_set.find(value) == _set.cend())
+        if (!this->contains(value))
             throw Exception(NOT_A_MEMBER, "The value is not a member of the group set...");
         if (!subgroup(set))
             throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
         Set<T> result ;
+        auto g = _id(value);
         for (auto&& x : set)
-            result.insert(at(x, value));
+            result.insert(_value(_op(_id(x), g)));
         return std::move(result);
     }
 
@@ -111,13 +222,14 @@ namespace zebra
     Set<T>
     Group<T>::right_coset(const Group<T>& group, const T& value) const 
     {
-        if (_set.find(value) == _set.cend())
+        if (!this->contains(value))
             throw Exception(NOT_A_MEMBER, "The value is not a member of the group set...");
         if (!subgroup(group))
             throw Exception(NOT_CONFORMANT, "The group does not form a subgroup...");
         Set<T> result ;
-        for (auto&& x : group._set)
-            result.insert(at(x, value));
+        auto g = _id(value);
+        for (auto&& x : _embed(group))
+            result.insert(_value(_op(x, g)));
         return std::move(result);
     }
 
@@ -125,13 +237,14 @@ namespace zebra
     Set<T>
     Group<T>::left_coset(const Set<T>& set, const T& value) const 
     {
-        if (_set.find(value) == _set.cend())
+        if (!this->contains(value))
             throw Exception(NOT_A_MEMBER, "The value is not a member of the group set...");
         if (!subgroup(set))
             throw Exception(NOT_CONFORMANT, "The set does not form a subgroup...");
         Set<T> result ;
+        auto g = _id(value);
         for (auto&& x : set)
-            result.insert(at(value, x));
+            result.insert(_value(_op(g, _id(x))));
         return std::move(result);
     }
 
@@ -139,39 +252,58 @@ namespace zebra
     Set<T>
     Group<T>::left_coset(const Group<T>& group, const T& value) const 
     {
-        if (_set.find(value) == _set.cend())
+        if (!this->contains(value))
             throw Exception(NOT_A_MEMBER, "The value is not a member of the group set...");
         if (!subgroup(group))
             throw Exception(NOT_CONFORMANT, "The group does not form a subgroup...");
         Set<T> result ;
-        for (auto&& x : group._set)
-            result.insert(at(value, x));
+        auto g = _id(value);
+        for (auto&& x : _embed(group))
+            result.insert(_value(_op(g, x)));
         return std::move(result);
     }
 
+    // The set is viewed through this group, so associativity is inherited
     template <typename T>
     bool
     Group<T>::subgroup(const Set<T>& set) const
     {
+        if (set.empty())
+            return false;
         for (auto&& x : set)
-            if (_set.find(x) == _set.cend())
+            if (!this->contains(x))
                 return false;
-        std::function<T(T, T)> mapf = [this] (T a, T b) -> T { return this->at(a, b); };
-        return zebra::is_group(set, mapf);
+        return Subgroup<T>{*this, set}.closed();
+    }
+
+    template <typename T>
+    bool
+    Group<T>::subgroup(const Sub<T, Group>& view) const
+    {
+        if (&view.parent().cells() != &this->cells())
+            return subgroup(view.elements());
+        return view.size() > 0 && view.closed();
     }
 
     template <typename T>
     bool
     Group<T>::subgroup(const Group<T>& group) const
     {
-        if (group._set.size() > _set.size())
+        if (group._order > _order)
             return false;
-        for (auto&& pair : group._table)
-        {
-            if (_table.count(pair.first) == 0 || _table.at(pair.first) != pair.second)
-                return false;
-        }
-        return true;
+        auto embed = _embed(group);
+        if (std::find(embed.cbegin(), embed.cend(), npos) != embed.cend())
+            return false;
+        return all2_ids(group._order, [this, &group, &embed](id_type x, id_type y) {
+            return embed[group._op(x, y)] == this->_op(embed[x], embed[y]);
+        });
+    }
+
+    template <typename T>
+    bool
+    Group<T>::_normal(const Bitset& members) const
+    {
+        return conjugacy().normal(members);
     }
 
     template <typename T>
@@ -180,212 +312,356 @@ namespace zebra
     {
         if (!subgroup(set))
             return false;
-        for (auto&& x : _set)
-        {
-            if (left_coset(set, x) != right_coset(set, x))
-                return false;
-        }
-        return true;
+        return _normal(Subgroup<T>{*this, set}.members());
     }
 
     template <typename T>
     bool
-    Group<T>::normal_subgroup(const Group<T>& group) const
+    Group<T>::normal_subgroup(const Sub<T, Group>& view) const
     {
-        if (!subgroup(group))
-            return false;
-        for (auto&& x : group._set)
-        {
-            if (left_coset(group, x) != right_coset(group, x))
-                return false;
-        }
-        return true;
+        if (&view.parent().cells() != &this->cells())
+            return normal_subgroup(view.elements());
+        return subgroup(view) && _normal(view.members());
     }
 
     template <typename T>
     bool
-    Group<T>::simple() const 
+    Group<T>::normal_subgroup(const Group<T>& group) const
     {
-        if (!normal_subgroup(*this))
-            return false;
-        if (at(_identity, _identity) != _identity)
+        if (!subgroup(group))
             return false;
-        Set<Set<T>> subs = all_subsets(_set);
-        // Check if any non-trivial group is also normal subgroup
-        // If that is the case, then it is not simple
-        for (auto&& sub : subs)
-            if (sub.size() > 1 && sub.find(_identity) != sub.end())
-                if (normal_subgroup(sub))
-                    return false ;
-        return true;
+        Bitset members(_order);
+        for (auto&& h : _embed(group))
+            members.set(h);
+        return _normal(members);
     }
 
+    // Two normal subgroups meeting trivially have |HK| = |H||K|, so HK = G
+    // is a matter of orders and no product has to be formed
     template <typename T>
     bool
     Group<T>::direct_sum(const Group<T>& lhs, const Group<T>& rhs) const
     {
         if (!normal_subgroup(lhs) || !normal_subgroup(rhs))
             return false;
-        auto result = intersection(lhs._set, rhs._set);
-        if (result.size() != 1 || *result.cbegin() != _identity)
+        if (static_cast<uint64_t>(lhs.order()) * rhs.order() != _order)
             return false;
-        result = combination(lhs._set, rhs._set);
-        HashMap<T, unsigned> count ;
-        for (auto&& c : _set)
-            count[c] = 0u;
-        for (auto&& x : result)
-            for (auto&& y : result)
-                count[at(x, y)]++ ;
-        for (auto&& c : _set)
-            if (count[c] == 0u)
+        auto left = _embed(lhs), right = _embed(rhs);
+        std::vector<bool> member(_order, false);
+        for (auto&& x : left)
+            member[x] = true ;
+        for (auto&& y : right)
+            if (member[y] && y != _identity_id)
                 return false;
-        return true;
+        return true ;
     }
 
+    // Binary exponentiation on the table, the exponent first reduced mod
+    // the order m of x into [0, m), which takes negative powers, INT64_MIN
+    // included, without negating k: x^-(j + 1) = x^(m - 1 - j mod m)
     template <typename T>
-    uint64_t
-    Group<T>::order(const T& element) const
+    id_type
+    Group<T>::_pow(id_type x, int64_t k) const
     {
-        uint64_t period = 0u;
-        while (period < std::numeric_limits<uint64_t>::max())
+        uint64_t m = orders()[x];
+        uint64_t e = k < 0 ? m - 1u - static_cast<uint64_t>(-(k + 1)) % m : static_cast<uint64_t>(k) % m ;
+        id_type result = _identity_id ;
+        for (; e > 0u; e >>= 1)
         {
-            element = at(element, element);
-            if (element == _identity)
-                return period ;
-            ++period;
+            if (e & 1u)
+                result = _op(result, x);
+            x = _op(x, x);
         }
-        return std::numeric_limits<uint64_t>::max();
+        return result ;
     }
 
+    // Walking the powers of g once gives the order m of g and, for free,
+    // the order m / gcd(k, m) of every g^k. Elements already met as a power
+    // are never walked again, so the whole spectrum costs about n lookups.
     template <typename T>
-    bool
-    Group<T>::pgroup(int64_t prime) const 
+    const std::vector<id_type>&
+    Group<T>::orders() const
     {
-        for (auto&& element : _set)
+        if (_orders)
+            return *_orders ;
+        std::vector<id_type> result(_order, 0u), powers ;
+        for (id_type g = 0; g < _order; ++g)
         {
-            int64_t product = prime, exp = 0u ;
-            while (product < std::numeric_limits<uint64_t>::max())
+            if (result[g] != 0u)
+                continue ;
+            powers.assign(1u, g);
+            while (powers.back() != _identity_id)
+                powers.push_back(_op(powers.back(), g));
+            auto m = static_cast<id_type>(powers.size());
+            for (id_type k = 1; k <= m; ++k)
             {
-                for (; exp < product; ++exp)
-                    element = at(element, element);
-                if (element != _identity)
-                    product *= prime ;
+                id_type a = k, b = m ;
+                while (b)
+                {
+                    auto t = a % b ;
+                    a = b ;
+                    b = t ;
+                }
+                result[powers[k - 1]] = m / a ;
             }
-            if (product >= std::numeric_limits<uint64_t>::max())
-                return false ;
         }
-        return true;
+        _orders = std::make_shared<const std::vector<id_type>>(std::move(result));
+        return *_orders ;
     }
 
+    // Greedy, elements of the largest order first: each new generator lies
+    // outside the subgroup generated so far, so there are at most log2 |G|
     template <typename T>
-    Set<Set<T>>
-    Group<T>::quotient(const Group<T>& group) const 
+    const std::vector<id_type>&
+    Group<T>::generating_set() const
     {
-        Set<Set<T>> quotient;
-        Set<T> temp;
-        if (!normal_subgroup(group))
-            throw Exception(NOT_CONFORMANT, "The group as argument is not a normal subgroup...");
-        for (auto&& x : _set)
+        if (_generating)
+            return *_generating ;
+        const auto& spectrum = orders();
+        std::vector<id_type> candidates(_order), result ;
+        for (id_type x = 0; x < _order; ++x)
+            candidates[x] = x ;
+        std::stable_sort(candidates.begin(), candidates.end(), [&spectrum](id_type x, id_type y) {
+            return spectrum[x] > spectrum[y];
+        });
+        Bitset members(_order);
+        members.set(_identity_id);
+        std::vector<id_type> queue(1u, _identity_id);
+        for (auto&& g : candidates)
         {
-            for (auto&& y : group._set)
-                temp.insert(at(x, y));
-            quotient.insert(temp);
-            temp.clear();
-        }   
-        return std::move(quotient);
+            if (members.test(g))
+                continue ;
+            result.push_back(g);
+            // Every old member times every generator, and the new ones
+            for (std::size_t k = 0; k < queue.size(); ++k)
+                for (std::size_t i = 0; i < result.size(); ++i)
+                {
+                    auto y = _op(queue[k], result[i]);
+                    if (!members.test(y))
+                    {
+                        members.set(y);
+                        queue.push_back(y);
+                    }
+                }
+        }
+        _generating = std::make_shared<const std::vector<id_type>>(std::move(result));
+        return *_generating ;
     }
 
-    template <typename A> Set<Set<A>> operator/(const Group<A>& lhs, const Group<A>& rhs)
+    template <typename T>
+    std::vector<T>
+    Group<T>::generators() const
     {
-        return lhs.quotient(rhs);
+        std::vector<T> result ;
+        for (auto&& g : generating_set())
+            result.push_back(_value(g));
+        return result ;
     }
 
-    template <typename A> Group<A> operator*(const Group<A>& lhs, const Group<A>& rhs)
+    template <typename T>
+    uint64_t
+    Group<T>::order(const T& element) const
     {
-        Group<Pair<A, A>> group ;
-        typedef typename Set<Pair<A, A>>::const_iterator itr;
-        group._set = lhs._set * rhs._set ;
-        for (auto&& pair1 : group._set)
-            for (auto&& pair2 : group._set)
-            {
-                auto g = lhs.at(pair1.first, pair2.first);
-                auto h = rhs.at(pair1.second, pair2.second);
-                auto index = Pair<itr, itr>(group._set.find(pair1.first, pair2.first), 
-                    group._set.find(pair1.second, pair2.second));
-                group._table[index] = group._set.find(Pair<A, A>(g, h));
-            }
-        return group;
+        return orders()[_id(element)];
     }
 
-    template <typename A> bool is_homomorphism(const Group<A>& lhs, const Group<A>& rhs, const Mapping<A, A>& map)
+    template <typename T>
+    uint64_t
+    Group<T>::exponent() const
     {
-        for (auto&& x : lhs._set)
-            for (auto&& y : lhs._set)
+        uint64_t result = 1u ;
+        for (auto&& m : orders())
+        {
+            uint64_t a = result, b = m ;
+            while (b)
             {
-                if (map.exists(lhs.at(x, y)) && map.exists(x) && map.exists(y))
-                    if (map(lhs.at(x, y)) != rhs.at(map(x), map(y)))
-                        return false;
+                auto t = a % b ;
+                a = b ;
+                b = t ;
             }
-        return true;
+            result = result / a * m ;
+        }
+        return result ;
     }
 
-    template <typename A> Error is_group(const Set<A>& set, const std::function<A(A, A)>& map)
+    template <typename T>
+    HashMap<uint64_t, std::size_t>
+    Group<T>::order_histogram() const
     {
-        bool closed = all2(set, [&map, &set](auto x, auto y) {
-            return set.find(map(x, y)) != set.end();
-        });
-        if (!closed)
-            return Error{NOT_CLOSED};
-        bool associative = all3(set, [&map](auto x, auto y, auto z) {
-            return map(x, map(y, z)) == map(map(x, y), z);
-        });
-        if (!associative)
-            return Error{NOT_ASSOCIATIVE};
-        A identity ;
-        bool has_identity = false ;
-        for (auto&& x : set)
-        {
-            identity = x ;
-            for (auto&& y : set)
-            {
-                has_identity = map(x, y) == y && map(y, x) == y; 
-                if (!has_identity)
-                    break;
-            }
-            if (has_identity)
-                break ;
-        }
-        if (!has_identity)
-            return Error{NO_IDENTITY};
-        bool has_inverse = false; 
-        for (auto&& x : set)
+        HashMap<uint64_t, std::size_t> result ;
+        for (auto&& m : orders())
+            ++result[m];
+        return result ;
+    }
+
+    // By Lagrange and Cauchy every element order is a power of p exactly
+    // when |G| is, so no element has to be looked at. Composite arguments
+    // are rejected, Z16 is not a 4-group.
+    template <typename T>
+    bool
+    Group<T>::pgroup(int64_t prime) const 
+    {
+        if (prime < 2)
+            return false ;
+        auto primes = prime_divisors(static_cast<uint64_t>(prime));
+        if (primes.size() != 1u || primes.front() != static_cast<uint64_t>(prime))
+            return false ;
+        uint64_t n = _order ;
+        while (n % prime == 0u)
+            n /= prime ;
+        return n == 1u ;
+    }
+
+    template <typename T>
+    bool
+    Group<T>::cyclic() const
+    {
+        bool prime = _order > 1u ;
+        for (uint64_t d = 2u; d * d <= _order && prime; ++d)
+            prime = _order % d != 0u ;
+        if (prime || _order == 1u)
+            return true ;
+        const auto& spectrum = orders();
+        return std::find(spectrum.cbegin(), spectrum.cend(), _order) != spectrum.cend();
+    }
+
+    template <typename T>
+    const Conjugacy&
+    Group<T>::conjugacy() const
+    {
+        if (!_conjugacy)
+            _conjugacy = std::make_shared<const Conjugacy>(*_cells, *_inverse);
+        return *_conjugacy ;
+    }
+
+    template <typename T>
+    bool
+    Group<T>::conjugate(const T& x, const T& y) const
+    {
+        return conjugacy().conjugate(_id(x), _id(y));
+    }
+
+    template <typename T>
+    Set<T>
+    Group<T>::conjugacy_class(const T& x) const
+    {
+        return _symbols->values(conjugacy().members(conjugacy().class_of(_id(x))));
+    }
+
+    template <typename T>
+    Set<Set<T>>
+    Group<T>::conjugacy_classes() const
+    {
+        Set<Set<T>> result ;
+        for (id_type c = 0; c < conjugacy().classes(); ++c)
+            result.insert(_symbols->values(conjugacy().members(c)));
+        return result ;
+    }
+
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::centralizer(const T& x) const
+    {
+        return Subgroup<T>{*this, conjugacy().centralizer(_id(x))};
+    }
+
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::center() const
+    {
+        return Subgroup<T>{*this, conjugacy().center()};
+    }
+
+    // The dense core of every is_group overload. Cells hold the id of the
+    // product or npos where it is undefined or outside the set. Closure,
+    // identity and inverses cost at most O(n^2) and are checked first, so
+    // the only cubic pass, associativity, runs last on a loop whose every
+    // other axiom holds, two table lookups per triple.
+    template <typename A> WitnessError<A> is_group(const Interner<A>& symbols, const std::vector<id_type>& cells)
+    {
+        id_type n = static_cast<id_type>(symbols.size());
+        if (cells.size() != static_cast<std::size_t>(n) * n)
+            return WitnessError<A>{NOT_CONFORMANT};
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                if (cells[static_cast<std::size_t>(x) * n + y] == npos)
+                    return WitnessError<A>{NOT_CLOSED, {symbols[x], symbols[y]}};
+        id_type identity = npos ;
+        for (id_type e = 0; e < n && identity == npos; ++e)
+            if (all_ids(n, [&cells, n, e](id_type y) {
+                    return cells[static_cast<std::size_t>(e) * n + y] == y && cells[static_cast<std::size_t>(y) * n + e] == y;
+                }))
+                identity = e ;
+        if (identity == npos)
+            return WitnessError<A>{NO_IDENTITY};
+        for (id_type x = 0; x < n; ++x)
+            if (!any_ids(n, [&cells, n, x, identity](id_type y) {
+                    return cells[static_cast<std::size_t>(x) * n + y] == identity && cells[static_cast<std::size_t>(y) * n + x] == identity;
+                }))
+                return WitnessError<A>{NO_INVERSE, {symbols[x]}};
+        for (id_type x = 0; x < n; ++x)
         {
-            for (auto&& y : set)
+            const id_type* row = &cells[static_cast<std::size_t>(x) * n];
+            for (id_type y = 0; y < n; ++y)
             {
-                has_inverse = map(x, y) == identity && map(y, x) == identity;
-                if (!has_inverse)
-                    break ;
+                const id_type* rowy = &cells[static_cast<std::size_t>(y) * n];
+                const id_type* rowxy = &cells[static_cast<std::size_t>(row[y]) * n];
+                for (id_type z = 0; z < n; ++z)
+                    if (row[rowy[z]] != rowxy[z])
+                        return WitnessError<A>{NOT_ASSOCIATIVE, {symbols[x], symbols[y], symbols[z]}};
             }
-            if (has_inverse)
-                break ;
         }
-        return has_inverse ? Error{NO_ERROR} : Error{NO_INVERSE};
+        return WitnessError<A>{NO_ERROR};
     }
 
-    template <typename A> Error is_group(const Set<A>& set, const HashMap<Pair<A, A>, A>& map)
+    // Any callable A x A -> A, evaluated exactly once per pair
+    template <typename A, typename F, typename>
+    WitnessError<A> is_group(const Set<A>& set, F&& map)
     {
-        auto mapf = [&map] (A a, A b) -> A { return map[Pair<A, A>(a, b)]; };
-        return is_group<A>(set, mapf);
+        Interner<A> symbols(set);
+        id_type n = static_cast<id_type>(symbols.size());
+        std::vector<id_type> cells(static_cast<std::size_t>(n) * n);
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                cells[static_cast<std::size_t>(x) * n + y] = symbols.find(map(symbols[x], symbols[y]));
+        return is_group(symbols, cells);
+    }
+
+    template <typename A> WitnessError<A> is_group(const Set<A>& set, const HashMap<Pair<A, A>, A>& map)
+    {
+        Interner<A> symbols(set);
+        id_type n = static_cast<id_type>(symbols.size());
+        std::vector<id_type> cells(static_cast<std::size_t>(n) * n, npos);
+        for (auto&& entry : map)
+        {
+            auto x = symbols.find(entry.first.first), y = symbols.find(entry.first.second);
+            if (x != npos && y != npos)
+                cells[static_cast<std::size_t>(x) * n + y] = symbols.find(entry.second);
+        }
+        return is_group(symbols, cells);
     }
 
-    template <typename A> Error is_group(const Set<A>& set, const Set<Triple<A, A, A>>& triples)
+    // One pass over the triples, a pair given two different products is
+    // not an operation at all
+    template <typename A> WitnessError<A> is_group(const Set<A>& set, const Set<Triple<A, A, A>>& triples)
     {
-        auto mapf = [&triples] (A a, A b) -> A { 
-            for (auto&& triplet : triples)
-                if (triplet.first == a && triplet.second == b)
-                    return triplet.third;
-        };
-        return is_group<A>(set, mapf);
+        Interner<A> symbols(set);
+        id_type n = static_cast<id_type>(symbols.size());
+        std::vector<id_type> cells(static_cast<std::size_t>(n) * n, npos);
+        std::vector<bool> given(cells.size(), false);
+        for (auto&& triplet : triples)
+        {
+            auto x = symbols.find(triplet.first), y = symbols.find(triplet.second);
+            if (x == npos || y == npos)
+                continue ;
+            auto pos = static_cast<std::size_t>(x) * n + y ;
+            auto z = symbols.find(triplet.third);
+            if (given[pos] && cells[pos] != z)
+                return WitnessError<A>{NOT_CONFORMANT, {triplet.first, triplet.second}};
+            given[pos] = true ;
+            cells[pos] = z ;
+        }
+        return is_group(symbols, cells);
     }
     
     template <typename T>
@@ -395,7 +671,7 @@ namespace zebra
         using typename Group<T>::table_type;
         using typename Group<T>::bin_op_type;
         using typename Group<T>::iter;
-        using Group<T>::_set;
+        using typename Group<T>::cells_type;
         using Group<T>::at;
         using Group<T>::_identity;
 
@@ -403,10 +679,21 @@ namespace zebra
         AbelianGroup(const table_type&, const Set<T>&);
         AbelianGroup(iter, iter, const Set<T>&);
         AbelianGroup(bin_op_type&&, const Set<T>&);
+        AbelianGroup(const cells_type&, const SharedInterner<T>&);
+
+        const std::vector<uint64_t>& invariant_factors() const ;
+        std::vector<uint64_t>        primary_decomposition() const ;
+        bool                         direct_sum(const Group<T>&, const Group<T>&) const ;
            
     protected:
         
+        using Group<T>::_order;
+        using Group<T>::_op;
+        using Group<T>::_identity_id;
+
         void check();
+
+        mutable std::shared_ptr<const std::vector<uint64_t>> _invariants ;
     };
     
     template <typename T>
@@ -425,7 +712,14 @@ namespace zebra
     
     template <typename T>
     AbelianGroup<T>::AbelianGroup(bin_op_type&& func, const Set<T>& set)
-        : Group<T>{func, set}
+        : Group<T>{std::move(func), set}
+    {
+        check();
+    }
+    
+    template <typename T>
+    AbelianGroup<T>::AbelianGroup(const cells_type& cells, const SharedInterner<T>& symbols)
+        : Group<T>{cells, symbols}
     {
         check();
     }
@@ -438,71 +732,197 @@ namespace zebra
             throw Exception(NOT_CONFORMANT, "Not all pairs are commutative");
     }
     
-    template <typename T>
+    // A homomorphism stored as the dense array of image ids. It is fixed
+    // by the images of a generating set: the map is extended by a breadth
+    // first search over the Cayley graph of the domain, phi(xs) being
+    // phi(x)phi(s), and every edge x -> xs met along the way is checked,
+    // which covers all the defining relations in O(|G| |gens|). A full
+    // mapping is checked the same way, on the edges of a small
+    // generating set only. Kernel and image are bitset views.
+    template <typename A, typename B = A>
     class GroupHomomorphism
     {
     public:
-        GroupHomomorphism(const Group<T>& lhs, const Group<T>& rhs, const Mapping<T, T>& map)
-            : _domain{lhs}, _codomain{rhs}, _mapping{map} { check(); }
-
-        Set<T> kernel() const ;
-        Set<T> image()  const ;
-        bool   monomorphism() const { return _mapping.injective(); }
-        bool   epimorphism() const { return _mapping.surjective(); }
-        bool   isomorphism() const { return _mapping.bijection(); }
-        bool   endomorphism() const { return _domain == _codomain; }
+        GroupHomomorphism() {}
+        GroupHomomorphism(const Group<A>&, const Group<B>&, const Mapping<A, B>&);
+        GroupHomomorphism(const Group<A>&, const Group<B>&, const std::vector<A>&, const std::vector<B>&);
+
+        const Group<A>&             domain() const { return _domain; }
+        const Group<B>&             codomain() const { return _codomain; }
+        const std::vector<id_type>& images() const { return _images; }
+        B                           at(const A& x) const { return _codomain.symbols()[_images[_domain.symbols().id(x)]]; }
+        B                           operator()(const A& x) const { return at(x); }
+        Mapping<A, B>               mapping() const ;
+
+        Sub<A, Group> kernel() const ;
+        Sub<B, Group> image()  const ;
+        bool   monomorphism() const { return kernel().size() == 1u; }
+        bool   epimorphism() const { return image().size() == _codomain.size(); }
+        bool   isomorphism() const { return monomorphism() && epimorphism(); }
+        bool   endomorphism() const ;
         bool   automorphism() const { return endomorphism() && isomorphism(); }
 
     protected:
 
-        void check();
+        void _extend(const std::vector<id_type>&, const std::vector<id_type>&);
 
-        Group<T> _domain, _codomain ;
-        Mapping<T, T> _mapping ;
+        Group<A>             _domain ;
+        Group<B>             _codomain ;
+        std::vector<id_type> _images ;
     };
 
-    template <typename T>
+    template <typename A, typename B>
+    GroupHomomorphism<A, B>::GroupHomomorphism(const Group<A>& lhs, const Group<B>& rhs,
+                                               const std::vector<A>& generators, const std::vector<B>& images)
+        : _domain{lhs}, _codomain{rhs}
+    {
+        if (generators.size() != images.size())
+            throw Exception(NOT_CONFORMANT, "Every generator needs exactly one image...");
+        std::vector<id_type> gens, targets ;
+        for (std::size_t i = 0; i < generators.size(); ++i)
+        {
+            gens.push_back(lhs.symbols().find(generators[i]));
+            targets.push_back(rhs.symbols().find(images[i]));
+            if (gens.back() == npos || targets.back() == npos)
+                throw Exception(NOT_A_MEMBER, "Generator or image not in its group...");
+        }
+        _extend(gens, targets);
+    }
+
+    template <typename A, typename B>
+    GroupHomomorphism<A, B>::GroupHomomorphism(const Group<A>& lhs, const Group<B>& rhs, const Mapping<A, B>& map)
+        : _domain{lhs}, _codomain{rhs}
+    {
+        std::vector<id_type> given(lhs.size(), npos);
+        for (id_type x = 0; x < lhs.size(); ++x)
+        {
+            if (map.exists(lhs.symbols()[x]))
+                given[x] = rhs.symbols().find(map(lhs.symbols()[x]));
+            if (given[x] == npos)
+                throw Exception(NOT_CONFORMANT, "The mapping is not defined on the whole group...");
+        }
+        auto gens = lhs.generating_set(), targets = gens ;
+        for (auto&& t : targets)
+            t = given[t];
+        _extend(gens, targets);
+        if (_images != given)
+            throw Exception(NOT_CONFORMANT, "It is not a homomorphism...");
+    }
+
+    template <typename A, typename B>
     void
-    GroupHomomorphism<T>::check()
+    GroupHomomorphism<A, B>::_extend(const std::vector<id_type>& gens, const std::vector<id_type>& targets)
     {
-        for (auto&& x : _domain._set)
-            for (auto&& y : _codomain._set)
+        auto n = static_cast<id_type>(_domain.size()), m = static_cast<id_type>(_codomain.size());
+        const auto& lhs = _domain.cells();
+        const auto& rhs = _codomain.cells();
+        auto identity = _domain.symbols().id(_domain.identity());
+        _images.assign(n, npos);
+        _images[identity] = _codomain.symbols().id(_codomain.identity());
+        std::vector<id_type> queue(1u, identity);
+        for (std::size_t k = 0; k < queue.size(); ++k)
+        {
+            auto x = queue[k];
+            for (std::size_t i = 0; i < gens.size(); ++i)
             {
-                if (_mapping.exists(_domain.at(x, y)) && _mapping.exists(x) && _mapping.exists(y))
-                    if (_mapping(_domain.at(x, y)) != _codomain.at(_mapping(x), _mapping(y)))
-                        throw Exception(NOT_CONFORMANT, "It is not a homomorphism...");
+                auto y = lhs[static_cast<std::size_t>(x) * n + gens[i]];
+                auto image = rhs[static_cast<std::size_t>(_images[x]) * m + targets[i]];
+                if (_images[y] == npos)
+                {
+                    _images[y] = image ;
+                    queue.push_back(y);
+                }
+                else if (_images[y] != image)
+                    throw Exception(NOT_CONFORMANT, "It is not a homomorphism...");
             }
+        }
+        if (queue.size() != n)
+            throw Exception(NOT_CONFORMANT, "The elements do not generate the domain...");
     }
 
-    template <typename T>
-    Set<T>
-    GroupHomomorphism<T>::kernel() const
+    template <typename A, typename B>
+    Mapping<A, B>
+    GroupHomomorphism<A, B>::mapping() const
     {
-        Set<T> result;
-        for (auto&& x : _domain._set)
-            if (_mapping.exists(x) && _mapping(x) == _codomain._identity)
-                result.insert(x);
-        return result;
+        return Mapping<A, B>{_domain.shared_symbols(), _codomain.shared_symbols(), _images};
     }
 
-    template <typename T>
-    Set<T>
-    GroupHomomorphism<T>::image() const
+    template <typename A, typename B>
+    Sub<A, Group>
+    GroupHomomorphism<A, B>::kernel() const
     {
-        Set<T> result;
-        for (auto&& x : _domain._set)
-            if (_mapping.exists(x))
-                result.insert(x);
-        return result;
+        Bitset result(_domain.size());
+        auto identity = _codomain.symbols().id(_codomain.identity());
+        for (id_type x = 0; x < _images.size(); ++x)
+            if (_images[x] == identity)
+                result.set(x);
+        return Sub<A, Group>{_domain, result};
+    }
+
+    template <typename A, typename B>
+    Sub<B, Group>
+    GroupHomomorphism<A, B>::image() const
+    {
+        Bitset result(_codomain.size());
+        for (auto&& y : _images)
+            result.set(y);
+        return Sub<B, Group>{_codomain, result};
+    }
+
+    namespace
+    {
+        template <typename A, typename B>
+        bool same_group(const Group<A>&, const Group<B>&)
+        {
+            return false ;
+        }
+
+        // Same carrier and the same table, possibly under other ids
+        template <typename T>
+        bool same_group(const Group<T>& lhs, const Group<T>& rhs)
+        {
+            if (&lhs.cells() == &rhs.cells())
+                return true ;
+            if (!same_symbols(lhs.symbols(), rhs.symbols()))
+                return false ;
+            auto ids = translation(lhs.symbols(), rhs.symbols());
+            auto n = static_cast<id_type>(lhs.size());
+            return all2_ids(n, [&](id_type x, id_type y) {
+                return ids[lhs.cells()[static_cast<std::size_t>(x) * n + y]] == rhs.cells()[static_cast<std::size_t>(ids[x]) * n + ids[y]];
+            });
+        }
+    }
+
+    template <typename A, typename B>
+    bool
+    GroupHomomorphism<A, B>::endomorphism() const
+    {
+        return same_group(_domain, _codomain);
+    }
+
+    template <typename A, typename B> bool is_homomorphism(const Group<A>& lhs, const Group<B>& rhs, const Mapping<A, B>& map)
+    {
+        try
+        {
+            GroupHomomorphism<A, B>{lhs, rhs, map};
+            return true ;
+        }
+        catch (const Exception&)
+        {
+            return false ;
+        }
     }
 
+    // The action is tabulated once as a dense |G| x |S| table of point ids,
+    // G is addressed through the ids of the group and S through an interner.
     template <typename G, typename S>
-    class GroupAction : public Mapping<Pair<G, S>, S>
+    class GroupAction
     {
     public:
         enum { LeftAction, RightAction };
+        typedef std::function<S(G, S)> action_type;
 
-        GroupAction(const Group<G>&, const Set<S>&, std::function<S(G, S)>&&, int = LeftAction);
+        GroupAction(const Group<G>&, const Set<S>&, action_type&&, int = LeftAction);
         GroupAction(const Group<G>&, const Set<S>&, const HashMap<Pair<G, S>, S>&, int = LeftAction);
 
         bool transitive() const ;
@@ -518,91 +938,126 @@ namespace zebra
         bool fixed_point(G, S) const ;
         Set<G> stabilizer_subgroup(S) const ;
 
-        using Mapping<Pair<G, S>, S>::at ;
+        S at(const G& g, const S& x) const { return (*_symbols)[_act(_group._id(g), _symbols->id(x))]; }
+        S at(const Pair<G, S>& pair) const { return at(pair.first, pair.second); }
+        S operator()(const G& g, const S& x) const { return at(g, x); }
+        Mapping<Pair<G, S>, S> mapping() const ;
 
     protected:
-        using Mapping<Pair<G, S>, S>::_from ;
-        using Mapping<Pair<G, S>, S>::_codomain ;
-        using Mapping<Pair<G, S>, S>::_relation ;
+        id_type _act(id_type g, id_type x) const { return _action[static_cast<std::size_t>(g) * _points + x]; }
+        std::vector<id_type> _orbit(id_type) const ;
 
-        Set<G> _gset;
-
-        template <typename A, typename B> friend operator/(const Set<A>&, const Group<B>&);
+        Group<G>             _group ;
+        Set<S>               _codomain ;
+        SharedInterner<S>    _symbols ;
+        std::vector<id_type> _action ;
+        id_type              _points ;
     };
 
     template <typename G, typename S>
-    GroupAction<G, S>::GroupAction(const Group<G>& group, const Set<S>& set, std::function<S(G, S)>&& map, int compatibility)
+    GroupAction<G, S>::GroupAction(const Group<G>& group, const Set<S>& set, action_type&& map, int compatibility)
+        : _group{group}, _codomain{set}, _symbols{make_interner(set)}
     {
-        auto identity = group.identity();
-        for (auto&& x : set)
-            if (map(identity, x) != x)
+        _points = static_cast<id_type>(_symbols->size());
+        _action.assign(static_cast<std::size_t>(group._order) * _points, npos);
+        for (id_type g = 0; g < group._order; ++g)
+            for (id_type x = 0; x < _points; ++x)
+            {
+                auto y = _symbols->find(map(group._value(g), (*_symbols)[x]));
+                if (y == npos)
+                    throw Exception(NOT_CONFORMANT, "Action is not closed on the set...");
+                _action[static_cast<std::size_t>(g) * _points + x] = y ;
+            }
+        for (id_type x = 0; x < _points; ++x)
+            if (_act(group._identity_id, x) != x)
                 throw Exception(NOT_CONFORMANT, "Identity axiom not satisfied...");
-        bool compatible = compatibility == LeftAction ? 
-        all(group._set, group._set, set, [&map, &group](auto g, auto h, auto x) { 
-            return map(group.at(g, h), x) == map(g, map(h, x));
-        }) :
-        all(group._set, group._set, set, [&map, &group](auto g, auto h, auto x) { 
-            return map(x, group.at(g, h)) == map(map(x, g), h);
+        // Left: (gh).x = g.(h.x), right: x.(gh) = (x.g).h
+        bool compatible = all2_ids(group._order, [this, &group, compatibility](id_type g, id_type h) {
+            for (id_type x = 0; x < this->_points; ++x)
+            {
+                auto lhs = this->_act(group._op(g, h), x);
+                auto rhs = compatibility == LeftAction ? this->_act(g, this->_act(h, x)) : this->_act(h, this->_act(g, x));
+                if (lhs != rhs)
+                    return false;
+            }
+            return true;
         });
+        if (!compatible)
+            throw Exception(NOT_CONFORMANT, "Compatibility failed...");
+    }
 
-        if (compatible)
+    template <typename G, typename S>
+    GroupAction<G, S>::GroupAction(const Group<G>& group, const Set<S>& set, const HashMap<Pair<G, S>, S>& map, int compatibility)
+        : GroupAction{group, set, [&map](G g, S x) { return map.at(Pair<G, S>(g, x)); }, compatibility}
+    {}
+
+    template <typename G, typename S>
+    std::vector<id_type>
+    GroupAction<G, S>::_orbit(id_type x) const
+    {
+        std::vector<bool> seen(_points, false);
+        std::vector<id_type> orbit ;
+        for (id_type g = 0; g < _group._order; ++g)
         {
-            _from = group._set * set ;
-            _codomain = set ;
-            _gset = group._set ;
-            all(group._set, set, [this, &map](auto x, auto y) mutable {
-                _relation[Pair<G, S>(x, y)] = map(x, y);
-            });
+            auto y = _act(g, x);
+            if (!seen[y])
+            {
+                seen[y] = true ;
+                orbit.push_back(y);
+            }
         }
-        else
-            throw Exception(NOT_CONFORMANT, "Compatibility failed...");
+        return orbit ;
     }
 
     template <typename G, typename S>
-    GroupAction<G, S>::GroupAction(const Group<G>& group, const Set<S>& set, const HashMap<Pair<G, S>, S>& map, int compatibility)
+    Mapping<Pair<G, S>, S>
+    GroupAction<G, S>::mapping() const
     {
-        auto mapping = [&map](auto x, auto y) { return map[Pair<G, S>(x, y)]; };
-        GroupAction(group, set, mapping, compatibility);
+        Set<Pair<Pair<G, S>, S>> pairs ;
+        Set<Pair<G, S>> from ;
+        for (id_type g = 0; g < _group._order; ++g)
+            for (id_type x = 0; x < _points; ++x)
+            {
+                from.insert(Pair<G, S>(_group._value(g), (*_symbols)[x]));
+                pairs.insert(Pair<Pair<G, S>, S>(Pair<G, S>(_group._value(g), (*_symbols)[x]), (*_symbols)[_act(g, x)]));
+            }
+        return Mapping<Pair<G, S>, S>{pairs, from, _codomain};
     }
 
     template <typename G, typename S>
     bool
     GroupAction<G, S>::transitive() const 
     {
-        return all(_codomain, _codomain, [this](auto x, auto y){
-            for (auto&& g : _gset)
-                if (this->at(Pair<G, S>(g, x)) == y)
-                    return true;
-            return false;
-        });
+        return _points == 0 || _orbit(0).size() == _points ;
     }
 
     template <typename G, typename S>
     bool
     GroupAction<G, S>::faithful() const
     {
-        return all(_gset, _gset, _codomain, [this](auto g, auto h, auto x){
-            return (g == h) ? true : this->at(Pair<G, S>(g, x)) != this->at(Pair<G, S>(h, x));
-        });
+        // Only the identity may act trivially
+        for (id_type g = 0; g < _group._order; ++g)
+            if (g != _group._identity_id && all_ids(_points, [this, g](id_type x) { return this->_act(g, x) == x; }))
+                return false;
+        return true;
     }
 
     template <typename G, typename S>
     bool
     GroupAction<G, S>::free() const
     {
-        return all(_gset, _gset, _codomain, [this](auto g, auto h, auto x){
-            return this->at(Pair<G, S>(g, x)) == this->at(Pair<G, S>(h, x)) ? g == h : true ;
-        });
+        for (id_type x = 0; x < _points; ++x)
+            for (id_type g = 0; g < _group._order; ++g)
+                if (g != _group._identity_id && _act(g, x) == x)
+                    return false;
+        return true;
     }
 
     template <typename G, typename S>
     Set<S>
     GroupAction<G, S>::orbit(S x) const 
     {
-        Set<S> result ;
-        for (auto&& g : _gset)
-            result.insert(at(Pair<G, S>(g, x)));
-        return result;
+        return _symbols->values(_orbit(_symbols->id(x)));
     }
 
     template <typename G, typename S>
@@ -610,8 +1065,15 @@ namespace zebra
     GroupAction<G, S>::orbit_space() const 
     {
         Set<Set<S>> result ;
-        for (auto&& x : _codomain)
-            result.insert(orbit(x));
+        std::vector<bool> seen(_points, false);
+        for (id_type x = 0; x < _points; ++x)
+            if (!seen[x])
+            {
+                auto orbit = _orbit(x);
+                for (auto&& y : orbit)
+                    seen[y] = true ;
+                result.insert(_symbols->values(orbit));
+            }
         return result;
     }
 
@@ -619,14 +1081,19 @@ namespace zebra
     bool
     GroupAction<G, S>::invariant(const Set<S>& set) const
     {
+        std::vector<bool> member(_points, false);
         for (auto&& x : set)
-            if (_codomain.find(x) == _codomain.end())
+        {
+            auto id = _symbols->find(x);
+            if (id == npos)
                 return false;
-        Set<S> result ;
-        each(_gset, set, [&result, this](auto g, auto y) mutable {
-            result.insert(this->at(Pair<G, S>(g, y)));
-        });
-        return result;
+            member[id] = true ;
+        }
+        for (id_type g = 0; g < _group._order; ++g)
+            for (id_type x = 0; x < _points; ++x)
+                if (member[x] && !member[_act(g, x)])
+                    return false;
+        return true;
     }
 
     template <typename G, typename S>
@@ -634,19 +1101,18 @@ namespace zebra
     GroupAction<G, S>::fixed(const Set<S>& set) const
     {
         for (auto&& x : set)
-            if (_codomain.find(x) == _codomain.end())
+            if (!_symbols->contains(x) || !ginvariant(x))
                 return false;
-        return all(_gset, set, [this](auto g, auto y) {
-            return this->at(Pair<G, S>(g, y)) == y;
-        });
+        return true;
     }
 
     template <typename G, typename S>
     bool
     GroupAction<G, S>::ginvariant(S x) const
     {
-        return all(_gset, [this, &x](auto g) {
-            return this->at(Pair<G, S>(g, x)) == x;
+        auto id = _symbols->id(x);
+        return all_ids(_group._order, [this, id](id_type g) {
+            return this->_act(g, id) == id;
         });
     }
 
@@ -655,9 +1121,9 @@ namespace zebra
     GroupAction<G, S>::ginvariants() const 
     {
         Set<S> result ;
-        for (auto&& x : _codomain)
-            if (ginvariant(x))
-                result.insert(x);
+        for (id_type x = 0; x < _points; ++x)
+            if (all_ids(_group._order, [this, x](id_type g) { return this->_act(g, x) == x; }))
+                result.insert((*_symbols)[x]);
         return result;
     }
 
@@ -665,7 +1131,7 @@ namespace zebra
     bool
     GroupAction<G, S>::fixed_point(G g, S x) const
     {
-        return at(Pair<G, S>(g, x)) == x ;
+        return at(g, x) == x ;
     } 
 
     template <typename G, typename S>
@@ -673,12 +1139,20 @@ namespace zebra
     GroupAction<G, S>::stabilizer_subgroup(S x) const
     {
         Set<G> result;
-        for (auto&& g : _gset)
-            if (at(Pair<G, S>(g, x)) == x)
-                result.insert(g);
+        auto id = _symbols->id(x);
+        for (id_type g = 0; g < _group._order; ++g)
+            if (_act(g, id) == id)
+                result.insert(_group._value(g));
         return result;
     }
 
 }
 
-#endif
\ No newline at end of file
+#include "lattice.hpp"
+#include "coset.hpp"
+#include "quotient.hpp"
+#include "series.hpp"
+#include "sylow.hpp"
+#include "abelian.hpp"
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef ZEBRA_HOMOMORPHISMS
+#define ZEBRA_HOMOMORPHISMS
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // Hom(G, H) by backtracking over the images of a generating set of G.
+    // The defining relations are the edges x -> x s of the Cayley graph of
+    // G: once the images of the first i generators are fixed, the map is
+    // extended over the subgroup they generate and every edge met is
+    // checked, so a bad choice is dropped at the level where it fails
+    // rather than at the leaves. The image of a generator of order m must
+    // have order dividing m, which bounds the candidates from the start.
+    //
+    // Counting needs no maps: conjugating by h in H permutes Hom(G, H), so
+    // the image of the first generator is taken up to conjugacy in H and
+    // the image of the second up to conjugacy by the centraliser of the
+    // first, each completion being weighted by the size of its orbit.
+    template <typename A, typename B>
+    class Homomorphisms
+    {
+    public:
+
+        Homomorphisms(const Group<A>&, const Group<B>&);
+
+        const Group<A>&             domain() const { return _domain; }
+        const Group<B>&             codomain() const { return _codomain; }
+        const std::vector<id_type>& generators() const { return _generators; }
+
+        template <typename F> void  each(F&&) const ;
+        std::vector<Mapping<A, B>>  all() const ;
+        uint64_t                    count() const ;
+
+    protected:
+
+        template <typename F> void _search(std::size_t, std::vector<id_type>&, std::vector<id_type>&, F&&) const ;
+        bool     _extend(std::size_t, const std::vector<id_type>&, std::vector<id_type>&) const ;
+        id_type  _hop(id_type x, id_type y) const { return _codomain.cells()[static_cast<std::size_t>(x) * _codomain.size() + y]; }
+
+        Group<A>                          _domain ;
+        Group<B>                          _codomain ;
+        std::vector<id_type>              _generators ;
+        std::vector<std::vector<id_type>> _candidates ;
+    };
+
+    template <typename A, typename B>
+    Homomorphisms<A, B>::Homomorphisms(const Group<A>& domain, const Group<B>& codomain)
+        : _domain{domain}, _codomain{codomain}, _generators{domain.generating_set()}
+    {
+        const auto& orders = domain.orders();
+        const auto& targets = codomain.orders();
+        for (auto&& g : _generators)
+        {
+            std::vector<id_type> candidates ;
+            for (id_type y = 0; y < codomain.size(); ++y)
+                if (orders[g] % targets[y] == 0u)
+                    candidates.push_back(y);
+            _candidates.push_back(std::move(candidates));
+        }
+    }
+
+    // Breadth first over the Cayley graph of the subgroup generated by the
+    // first count generators, images[xs] = images[x] targets[s]
+    template <typename A, typename B>
+    bool
+    Homomorphisms<A, B>::_extend(std::size_t count, const std::vector<id_type>& targets, std::vector<id_type>& images) const
+    {
+        auto n = static_cast<id_type>(_domain.size());
+        const auto& cells = _domain.cells();
+        auto identity = _domain.symbols().id(_domain.identity());
+        images.assign(n, npos);
+        images[identity] = _codomain.symbols().id(_codomain.identity());
+        std::vector<id_type> queue(1u, identity);
+        for (std::size_t k = 0; k < queue.size(); ++k)
+        {
+            auto x = queue[k];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto y = cells[static_cast<std::size_t>(x) * n + _generators[i]];
+                auto image = _hop(images[x], targets[i]);
+                if (images[y] == npos)
+                {
+                    images[y] = image ;
+                    queue.push_back(y);
+                }
+                else if (images[y] != image)
+                    return false ;
+            }
+        }
+        return true ;
+    }
+
+    template <typename A, typename B>
+    template <typename F>
+    void
+    Homomorphisms<A, B>::_search(std::size_t level, std::vector<id_type>& targets, std::vector<id_type>& images, F&& leaf) const
+    {
+        if (level == _generators.size())
+        {
+            if (_extend(level, targets, images))
+                leaf(images);
+            return ;
+        }
+        for (auto&& y : _candidates[level])
+        {
+            targets[level] = y ;
+            if (_extend(level + 1u, targets, images))
+                _search(level + 1u, targets, images, leaf);
+        }
+    }
+
+    // Calls back with every homomorphism as a dense Mapping, one at a time
+    template <typename A, typename B>
+    template <typename F>
+    void
+    Homomorphisms<A, B>::each(F&& function) const
+    {
+        std::vector<id_type> targets(_generators.size(), npos), images ;
+        _search(0u, targets, images, [this, &function](const std::vector<id_type>& images) {
+            function(Mapping<A, B>{this->_domain.shared_symbols(), this->_codomain.shared_symbols(), images});
+        });
+    }
+
+    template <typename A, typename B>
+    std::vector<Mapping<A, B>>
+    Homomorphisms<A, B>::all() const
+    {
+        std::vector<Mapping<A, B>> result ;
+        each([&result](const Mapping<A, B>& map) { result.push_back(map); });
+        return result ;
+    }
+
+    template <typename A, typename B>
+    uint64_t
+    Homomorphisms<A, B>::count() const
+    {
+        std::vector<id_type> targets(_generators.size(), npos), images ;
+        if (_generators.empty())
+            return 1u ;
+        uint64_t total = 0u ;
+        const auto& conjugacy = _codomain.conjugacy();
+        const auto& inverse = _codomain.inverses();
+        std::vector<bool> seen(conjugacy.classes(), false);
+        for (auto&& y : _candidates[0])
+        {
+            auto c = conjugacy.class_of(y);
+            if (seen[c])
+                continue ;
+            seen[c] = true ;
+            targets[0] = y ;
+            if (!_extend(1u, targets, images))
+                continue ;
+            uint64_t completions = 0u ;
+            if (_generators.size() == 1u)
+                completions = 1u ;
+            else
+            {
+                // Orbits of the centraliser of y on the second candidates
+                const auto& centralizer = conjugacy.centralizer(y);
+                std::vector<bool> reached(_codomain.size(), false);
+                for (auto&& z : _candidates[1])
+                {
+                    if (reached[z])
+                        continue ;
+                    uint64_t orbit = 0u ;
+                    centralizer.each([&](std::size_t h) {
+                        auto w = this->_hop(this->_hop(inverse[h], z), static_cast<id_type>(h));
+                        if (!reached[w])
+                        {
+                            reached[w] = true ;
+                            ++orbit ;
+                        }
+                    });
+                    targets[1] = z ;
+                    uint64_t leaves = 0u ;
+                    if (_extend(2u, targets, images))
+                        _search(2u, targets, images, [&leaves](const std::vector<id_type>&) { ++leaves; });
+                    completions += orbit * leaves ;
+                }
+            }
+            total += conjugacy.class_size(c) * completions ;
+        }
+        return total ;
+    }
+
+    template <typename A, typename B> std::vector<Mapping<A, B>> homomorphisms(const Group<A>& lhs, const Group<B>& rhs)
+    {
+        return Homomorphisms<A, B>{lhs, rhs}.all();
+    }
+
+    template <typename A, typename B> uint64_t count_homomorphisms(const Group<A>& lhs, const Group<B>& rhs)
+    {
+        return Homomorphisms<A, B>{lhs, rhs}.count();
+    }
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
+#include <limits>
+#include <cstdint>
 #include <utility>
 #include <algorithm>
 #include <type_traits>
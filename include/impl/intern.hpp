@@ -0,0 +1,223 @@
+#ifndef ZEBRA_INTERN
+#define ZEBRA_INTERN
+
+#include "utils.hpp"
+
+namespace zebra
+{
+    typedef uint32_t id_type ;
+
+    const id_type npos = std::numeric_limits<id_type>::max();
+
+    // Maps arbitrary values to dense ids [0, size()) in insertion order.
+    // Ids are never invalidated, so an interner can be shared between
+    // related structures and all of them can keep working on ids alone.
+    template <typename T>
+    class Interner
+    {
+    public:
+
+        typedef typename std::vector<T>::const_iterator iter ;
+
+        Interner() {}
+        Interner(const Set<T>&);
+        template <typename I> Interner(I, I);
+
+        id_type     intern(const T&);
+        id_type     id(const T&) const ;
+        id_type     find(const T&) const ;
+        bool        contains(const T& val) const { return _ids.count(val) > 0; }
+        const T&    at(id_type id) const { return _symbols.at(id); }
+        const T&    operator[](id_type id) const { return _symbols[id]; }
+        std::size_t size() const { return _symbols.size(); }
+        iter        cbegin() const { return _symbols.cbegin(); }
+        iter        cend() const { return _symbols.cend(); }
+        void        reserve(std::size_t);
+
+        template <typename C> std::vector<id_type> ids(const C&) const ;
+        template <typename C> Set<T> values(const C&) const ;
+
+    protected:
+
+        std::vector<T>      _symbols ;
+        HashMap<T, id_type> _ids ;
+    };
+
+    template <typename T> using SymbolTable = Interner<T>;
+    template <typename T> using SharedInterner = std::shared_ptr<Interner<T>>;
+
+    template <typename T>
+    SharedInterner<T> make_interner(const Set<T>& set)
+    {
+        return std::make_shared<Interner<T>>(set);
+    }
+
+    template <typename T>
+    Interner<T>::Interner(const Set<T>& set)
+    {
+        reserve(set.size());
+        for (auto&& element : set)
+            intern(element);
+    }
+
+    template <typename T>
+    template <typename I>
+    Interner<T>::Interner(I start, I end)
+    {
+        for (; start != end; ++start)
+            intern(*start);
+    }
+
+    template <typename T>
+    void
+    Interner<T>::reserve(std::size_t count)
+    {
+        _symbols.reserve(count);
+        _ids.reserve(count);
+    }
+
+    template <typename T>
+    id_type
+    Interner<T>::intern(const T& val)
+    {
+        auto it = _ids.find(val);
+        if (it != _ids.cend())
+            return it->second ;
+        if (_symbols.size() >= npos)
+            throw Exception(NOT_CONFORMANT, "Too many symbols to intern...");
+        id_type next = static_cast<id_type>(_symbols.size());
+        _symbols.push_back(val);
+        _ids.emplace(val, next);
+        return next ;
+    }
+
+    template <typename T>
+    id_type
+    Interner<T>::find(const T& val) const
+    {
+        auto it = _ids.find(val);
+        return it == _ids.cend() ? npos : it->second ;
+    }
+
+    template <typename T>
+    id_type
+    Interner<T>::id(const T& val) const
+    {
+        auto it = _ids.find(val);
+        if (it == _ids.cend())
+            throw Exception(NOT_A_MEMBER, "The value has not been interned...");
+        return it->second ;
+    }
+
+    template <typename T>
+    template <typename C>
+    std::vector<id_type>
+    Interner<T>::ids(const C& container) const
+    {
+        std::vector<id_type> result ;
+        result.reserve(container.size());
+        for (auto&& element : container)
+            result.push_back(id(element));
+        return result ;
+    }
+
+    template <typename T>
+    template <typename C>
+    Set<T>
+    Interner<T>::values(const C& container) const
+    {
+        Set<T> result ;
+        for (auto&& id : container)
+            result.insert(at(id));
+        return result ;
+    }
+
+    // Id of every symbol of 'from' inside 'to', npos where it is missing.
+    template <typename T>
+    std::vector<id_type> translation(const Interner<T>& from, const Interner<T>& to)
+    {
+        std::vector<id_type> result(from.size(), npos);
+        for (id_type i = 0; i < from.size(); ++i)
+            result[i] = &from == &to ? i : to.find(from[i]);
+        return result ;
+    }
+
+    // Whether two interners hold the same symbols, possibly under other ids
+    template <typename T>
+    bool same_symbols(const Interner<T>& lhs, const Interner<T>& rhs)
+    {
+        if (&lhs == &rhs)
+            return true ;
+        if (lhs.size() != rhs.size())
+            return false ;
+        for (auto it = lhs.cbegin(); it != lhs.cend(); ++it)
+            if (!rhs.contains(*it))
+                return false ;
+        return true ;
+    }
+
+    // Loops over dense ids [0, n), the id counterparts of all/any in utils.hpp
+
+    template <typename F>
+    bool all_ids(id_type n, F&& function)
+    {
+        for (id_type x = 0; x < n; ++x)
+            if (!function(x))
+                return false ;
+        return true ;
+    }
+
+    template <typename F>
+    bool all2_ids(id_type n, F&& function)
+    {
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                if (!function(x, y))
+                    return false ;
+        return true ;
+    }
+
+    template <typename F>
+    bool all3_ids(id_type n, F&& function)
+    {
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                for (id_type z = 0; z < n; ++z)
+                    if (!function(x, y, z))
+                        return false ;
+        return true ;
+    }
+
+    template <typename F>
+    bool all4_ids(id_type n, F&& function)
+    {
+        for (id_type w = 0; w < n; ++w)
+            for (id_type x = 0; x < n; ++x)
+                for (id_type y = 0; y < n; ++y)
+                    for (id_type z = 0; z < n; ++z)
+                        if (!function(w, x, y, z))
+                            return false ;
+        return true ;
+    }
+
+    template <typename F>
+    bool any_ids(id_type n, F&& function)
+    {
+        for (id_type x = 0; x < n; ++x)
+            if (function(x))
+                return true ;
+        return false ;
+    }
+
+    template <typename F>
+    bool any2_ids(id_type n, F&& function)
+    {
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                if (function(x, y))
+                    return true ;
+        return false ;
+    }
+}
+
+#endif
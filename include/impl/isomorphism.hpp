@@ -0,0 +1,161 @@
+#ifndef ZEBRA_ISOMORPHISM
+#define ZEBRA_ISOMORPHISM
+
+#include "group.hpp"
+
+namespace zebra
+{
+    namespace
+    {
+        // Every element is coloured by its order and the size of its class,
+        // both preserved by isomorphisms. The sorted colours already carry
+        // the order histogram, the class sizes and the order of the centre.
+        template <typename T>
+        std::vector<uint64_t> element_colours(const Group<T>& group)
+        {
+            const auto& orders = group.orders();
+            const auto& conjugacy = group.conjugacy();
+            std::vector<uint64_t> result(group.size());
+            for (id_type x = 0; x < group.size(); ++x)
+                result[x] = static_cast<uint64_t>(orders[x]) * (group.size() + 1u) + conjugacy.class_size(conjugacy.class_of(x));
+            return result ;
+        }
+
+        // Orders of the terms of the derived and lower central series,
+        // then the number of Sylow subgroups for every prime
+        template <typename T>
+        std::vector<std::size_t> series_orders(const Group<T>& group)
+        {
+            std::vector<std::size_t> result ;
+            for (auto&& p : prime_divisors(group.order()))
+                result.push_back(group.sylow_count(static_cast<int64_t>(p)));
+            result.push_back(0u);
+            for (auto&& term : group.derived_series())
+                result.push_back(term.size());
+            result.push_back(0u);
+            for (auto&& term : group.lower_central_series())
+                result.push_back(term.size());
+            return result ;
+        }
+
+        // Backtracking over the images of a generating set of G. Before a
+        // generator is tried at the next level, the map fixed so far is
+        // extended over the subgroup generated so far, by a breadth first
+        // search on its Cayley graph, and rejected on the first
+        // inconsistent edge, collision or change of colour.
+        template <typename A, typename B>
+        class IsomorphismSearch
+        {
+        public:
+            IsomorphismSearch(const Group<A>& lhs, const Group<B>& rhs)
+                : _lhs{lhs}, _rhs{rhs}, _n{static_cast<id_type>(lhs.size())},
+                  _generators{lhs.generating_set()}, _targets(_generators.size(), npos)
+            {
+                _lcolours = element_colours(lhs);
+                _rcolours = element_colours(rhs);
+            }
+
+            bool invariants() const ;
+            bool search(std::size_t);
+            const std::vector<id_type>& images() const { return _images; }
+
+        protected:
+
+            bool _extend(std::size_t);
+
+            const Group<A>&       _lhs ;
+            const Group<B>&       _rhs ;
+            id_type               _n ;
+            std::vector<id_type>  _generators, _targets, _images ;
+            std::vector<uint64_t> _lcolours, _rcolours ;
+        };
+
+        template <typename A, typename B>
+        bool
+        IsomorphismSearch<A, B>::invariants() const
+        {
+            if (_lhs.size() != _rhs.size())
+                return false ;
+            auto lhs = _lcolours, rhs = _rcolours ;
+            std::sort(lhs.begin(), lhs.end());
+            std::sort(rhs.begin(), rhs.end());
+            return lhs == rhs && series_orders(_lhs) == series_orders(_rhs);
+        }
+
+        template <typename A, typename B>
+        bool
+        IsomorphismSearch<A, B>::search(std::size_t level)
+        {
+            if (level == _generators.size())
+                return _extend(level);
+            for (id_type y = 0; y < _n; ++y)
+            {
+                if (_rcolours[y] != _lcolours[_generators[level]])
+                    continue ;
+                _targets[level] = y ;
+                if (_extend(level + 1u) && search(level + 1u))
+                    return true ;
+            }
+            _targets[level] = npos ;
+            return false ;
+        }
+
+        template <typename A, typename B>
+        bool
+        IsomorphismSearch<A, B>::_extend(std::size_t count)
+        {
+            const auto& lcells = _lhs.cells();
+            const auto& rcells = _rhs.cells();
+            auto identity = _lhs.symbols().id(_lhs.identity());
+            _images.assign(_n, npos);
+            std::vector<bool> hit(_n, false);
+            _images[identity] = _rhs.symbols().id(_rhs.identity());
+            hit[_images[identity]] = true ;
+            std::vector<id_type> queue(1u, identity);
+            for (std::size_t k = 0; k < queue.size(); ++k)
+            {
+                auto x = queue[k];
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto y = lcells[static_cast<std::size_t>(x) * _n + _generators[i]];
+                    auto image = rcells[static_cast<std::size_t>(_images[x]) * _n + _targets[i]];
+                    if (_images[y] != npos)
+                    {
+                        if (_images[y] != image)
+                            return false ;
+                        continue ;
+                    }
+                    if (hit[image] || _lcolours[y] != _rcolours[image])
+                        return false ;
+                    _images[y] = image ;
+                    hit[image] = true ;
+                    queue.push_back(y);
+                }
+            }
+            return true ;
+        }
+    }
+
+    template <typename A, typename B> bool isomorphic(const Group<A>& lhs, const Group<B>& rhs)
+    {
+        IsomorphismSearch<A, B> search{lhs, rhs};
+        return search.invariants() && search.search(0u);
+    }
+
+    // Abelian groups are isomorphic exactly when their invariant factors agree
+    template <typename A, typename B> bool isomorphic(const AbelianGroup<A>& lhs, const AbelianGroup<B>& rhs)
+    {
+        return lhs.invariant_factors() == rhs.invariant_factors();
+    }
+
+    // An isomorphism from lhs onto rhs, DOES_NOT_EXIST when there is none
+    template <typename A, typename B> Mapping<A, B> isomorphism(const Group<A>& lhs, const Group<B>& rhs)
+    {
+        IsomorphismSearch<A, B> search{lhs, rhs};
+        if (!search.invariants() || !search.search(0u))
+            throw Exception(DOES_NOT_EXIST, "The groups are not isomorphic...");
+        return Mapping<A, B>{lhs.shared_symbols(), rhs.shared_symbols(), search.images()};
+    }
+}
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef ZEBRA_LATTICE
+#define ZEBRA_LATTICE
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // The lattice of subgroups (or of normal subgroups) of a finite group.
+    // Every subgroup is the join of the cyclic subgroups it contains, so the
+    // lattice is enumerated from the trivial group by repeatedly joining a
+    // known subgroup with a cyclic one, the join being a closure under the
+    // generators. For normal subgroups the atoms are the normal closures of
+    // single elements instead. Subgroups are membership bitsets over the
+    // group's ids, deduplicated by hashing, and ordered by increasing order
+    // so that index 0 is the trivial group and the last one the group.
+    template <typename T>
+    class SubgroupLattice
+    {
+    public:
+        enum { Subgroups, NormalSubgroups };
+
+        SubgroupLattice() {}
+        SubgroupLattice(const Group<T>&, int = Subgroups);
+
+        std::size_t                     size() const { return _subgroups.size(); }
+        const Group<T>&                 group() const { return _group; }
+        const std::vector<Subgroup<T>>& subgroups() const { return _subgroups; }
+        const Subgroup<T>&              operator[](std::size_t i) const { return _subgroups[i]; }
+        std::size_t                     find(const Bitset&) const ;
+        std::size_t                     bottom() const { return 0u; }
+        std::size_t                     top() const { return _subgroups.size() - 1u; }
+        const std::vector<std::size_t>& covers(std::size_t i) const { return _up[i]; }
+        const std::vector<std::size_t>& covered(std::size_t i) const { return _down[i]; }
+        bool                            leq(std::size_t i, std::size_t j) const { return _subgroups[i].members().subset_of(_subgroups[j].members()); }
+        std::size_t                     join(std::size_t, std::size_t) const ;
+        std::size_t                     meet(std::size_t, std::size_t) const ;
+        std::vector<std::size_t>        maximal() const { return _down[top()]; }
+        std::vector<std::size_t>        minimal() const { return _up[bottom()]; }
+        bool                            normal(std::size_t i) const { return _normal[i]; }
+        std::vector<std::size_t>        normal() const ;
+        bool                            simple() const ;
+        BinaryRelation<std::size_t, std::size_t> relation() const ;
+
+    protected:
+
+        id_type _op(id_type x, id_type y) const { return _group.cells()[static_cast<std::size_t>(x) * _order + y]; }
+        Bitset  _closure(const Bitset&, const std::vector<id_type>&) const ;
+
+        Group<T>                          _group ;
+        id_type                           _order = 0 ;
+        id_type                           _identity = 0 ;
+        std::vector<Subgroup<T>>          _subgroups ;
+        std::vector<std::vector<id_type>> _generators ;
+        std::vector<bool>                 _normal ;
+        std::vector<std::vector<std::size_t>> _up, _down ;
+        HashMap<Bitset, std::size_t>      _index ;
+    };
+
+    template <typename T>
+    SubgroupLattice<T>::SubgroupLattice(const Group<T>& group, int kind)
+        : _group{group}, _order{static_cast<id_type>(group.order())}
+    {
+        _identity = group.symbols().id(group.identity());
+
+        // Atoms: <g>, or the normal closure of g, generated by its class
+        std::vector<Bitset> atoms ;
+        std::vector<std::vector<id_type>> atom_generators ;
+        Set<Bitset> seen ;
+        Bitset trivial(_order);
+        trivial.set(_identity);
+        for (id_type g = 0; g < _order; ++g)
+        {
+            if (g == _identity)
+                continue ;
+            std::vector<id_type> generators(1u, g);
+            if (kind == NormalSubgroups)
+                generators = group.conjugacy().members(group.conjugacy().class_of(g));
+            auto atom = _closure(trivial, generators);
+            if (seen.insert(atom).second)
+            {
+                atoms.push_back(atom);
+                atom_generators.push_back(generators);
+            }
+        }
+
+        std::vector<Bitset> found(1u, trivial);
+        std::vector<std::vector<id_type>> generators(1u);
+        HashMap<Bitset, std::size_t> index ;
+        index.emplace(trivial, 0u);
+        for (std::size_t i = 0; i < found.size(); ++i)
+            for (std::size_t a = 0; a < atoms.size(); ++a)
+            {
+                if (atoms[a].subset_of(found[i]))
+                    continue ;
+                auto gens = generators[i];
+                gens.insert(gens.end(), atom_generators[a].cbegin(), atom_generators[a].cend());
+                auto join = _closure(found[i], gens);
+                if (index.emplace(join, found.size()).second)
+                {
+                    found.push_back(std::move(join));
+                    generators.push_back(std::move(gens));
+                }
+            }
+
+        std::vector<std::size_t> order(found.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i ;
+        std::vector<std::size_t> counts(found.size());
+        for (std::size_t i = 0; i < found.size(); ++i)
+            counts[i] = found[i].count();
+        std::stable_sort(order.begin(), order.end(), [&counts](std::size_t a, std::size_t b) {
+            return counts[a] < counts[b];
+        });
+        for (auto&& i : order)
+        {
+            _index.emplace(found[i], _subgroups.size());
+            _subgroups.push_back(Subgroup<T>{_group, found[i]});
+            _normal.push_back(kind == NormalSubgroups || group.conjugacy().normal(found[i]));
+            _generators.push_back(std::move(generators[i]));
+        }
+
+        // Hasse diagram: j covers i when nothing lies strictly in between
+        _up.assign(size(), std::vector<std::size_t>{});
+        _down.assign(size(), std::vector<std::size_t>{});
+        for (std::size_t j = 0; j < size(); ++j)
+        {
+            std::vector<std::size_t> below ;
+            for (std::size_t i = 0; i < j; ++i)
+                if (_subgroups[i].size() < _subgroups[j].size() && leq(i, j))
+                    below.push_back(i);
+            for (std::size_t b = below.size(); b > 0; --b)
+            {
+                auto i = below[b - 1];
+                bool cover = true ;
+                for (auto&& k : _down[j])
+                    cover = cover && !leq(i, k);
+                if (cover)
+                {
+                    _down[j].push_back(i);
+                    _up[i].push_back(j);
+                }
+            }
+        }
+    }
+
+    // Closure of a subgroup under further generators, O(|result| |gens|)
+    template <typename T>
+    Bitset
+    SubgroupLattice<T>::_closure(const Bitset& members, const std::vector<id_type>& generators) const
+    {
+        Bitset result = members ;
+        std::vector<id_type> queue ;
+        members.each([&queue](std::size_t x) { queue.push_back(static_cast<id_type>(x)); });
+        for (std::size_t i = 0; i < queue.size(); ++i)
+            for (auto&& s : generators)
+            {
+                auto y = _op(queue[i], s);
+                if (!result.test(y))
+                {
+                    result.set(y);
+                    queue.push_back(y);
+                }
+            }
+        return result ;
+    }
+
+    template <typename T>
+    std::size_t
+    SubgroupLattice<T>::find(const Bitset& members) const
+    {
+        auto it = _index.find(members);
+        return it == _index.cend() ? size() : it->second ;
+    }
+
+    template <typename T>
+    std::size_t
+    SubgroupLattice<T>::join(std::size_t i, std::size_t j) const
+    {
+        auto generators = _generators[i];
+        generators.insert(generators.end(), _generators[j].cbegin(), _generators[j].cend());
+        return find(_closure(_subgroups[i].members(), generators));
+    }
+
+    template <typename T>
+    std::size_t
+    SubgroupLattice<T>::meet(std::size_t i, std::size_t j) const
+    {
+        return find(_subgroups[i].members() & _subgroups[j].members());
+    }
+
+    template <typename T>
+    std::vector<std::size_t>
+    SubgroupLattice<T>::normal() const
+    {
+        std::vector<std::size_t> result ;
+        for (std::size_t i = 0; i < size(); ++i)
+            if (_normal[i])
+                result.push_back(i);
+        return result ;
+    }
+
+    // Exactly two normal subgroups, the trivial one and the group itself
+    template <typename T>
+    bool
+    SubgroupLattice<T>::simple() const
+    {
+        return size() > 1u && normal().size() == 2u ;
+    }
+
+    template <typename T>
+    BinaryRelation<std::size_t, std::size_t>
+    SubgroupLattice<T>::relation() const
+    {
+        Set<std::size_t> indices ;
+        for (std::size_t i = 0; i < size(); ++i)
+            indices.insert(i);
+        return BinaryRelation<std::size_t, std::size_t>{[this](std::size_t i, std::size_t j) { return this->leq(i, j); }, indices};
+    }
+
+    // A p-group is simple only when of prime order, its centre being a
+    // proper normal subgroup otherwise, and a unique Sylow subgroup is
+    // normal. Only past those is the lattice of normal subgroups built.
+    template <typename T>
+    bool
+    Group<T>::simple() const
+    {
+        if (_order == 1u)
+            return false ;
+        auto primes = prime_divisors(_order);
+        if (primes.size() == 1u)
+            return primes.front() == _order ;
+        for (auto&& p : primes)
+            if (sylow_count(static_cast<int64_t>(p)) == 1u)
+                return false ;
+        return SubgroupLattice<T>{*this, SubgroupLattice<T>::NormalSubgroups}.simple();
+    }
+
+    template <typename T>
+    SubgroupLattice<T>
+    Group<T>::lattice() const
+    {
+        return SubgroupLattice<T>{*this};
+    }
+
+    template <typename T>
+    std::vector<Subgroup<T>>
+    Group<T>::normal_subgroups() const
+    {
+        return SubgroupLattice<T>{*this, SubgroupLattice<T>::NormalSubgroups}.subgroups();
+    }
+
+    template <typename T>
+    std::vector<Subgroup<T>>
+    Group<T>::maximal_subgroups() const
+    {
+        SubgroupLattice<T> lattice{*this};
+        std::vector<Subgroup<T>> result ;
+        for (auto&& i : lattice.maximal())
+            result.push_back(lattice[i]);
+        return result ;
+    }
+}
+
+#endif
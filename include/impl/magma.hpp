@@ -6,13 +6,13 @@
 
 namespace zebra
 {
-    
+    class PermutationGroup ;
+
     template <typename T>
     class Magma : public BinaryOperation<T>
     {
     public:
         using BinaryOperation<T>::BinaryOperation ;
-        using BinaryOperation<T>::_set;
         
         bool medial() const ;
         bool left_semimedial() const ;
@@ -38,17 +38,24 @@ namespace zebra
         bool right_zero_semigroup() const ;
         bool trimedial() const ;
         bool entropic() const ;
+
+        PermutationGroup automorphisms() const ;
         
     protected:
+        using BinaryOperation<T>::_order;
+        using BinaryOperation<T>::_op;
+        using BinaryOperation<T>::_value;
+
         bool identity_extract(T&) const ;
+        bool _identity_extract(id_type&) const ;
     };
     
     template <typename T>
     bool
     Magma<T>::medial() const
     {
-        return all4(_set, [this] (auto u, auto v, auto x, auto y) -> bool {
-            return this->at(this->at(u, v), this->at(x, y)) == this->at(this->at(u, x), this->at(v, y));
+        return all4_ids(_order, [this] (id_type u, id_type v, id_type x, id_type y) -> bool {
+            return this->_op(this->_op(u, v), this->_op(x, y)) == this->_op(this->_op(u, x), this->_op(v, y));
         });
     }
     
@@ -56,8 +63,8 @@ namespace zebra
     bool
     Magma<T>::left_semimedial() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(this->at(x, x), this->at(y, z)) == this->at(this->at(x, y), this->at(x, z));
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(this->_op(x, x), this->_op(y, z)) == this->_op(this->_op(x, y), this->_op(x, z));
         });
     }
     
@@ -65,8 +72,8 @@ namespace zebra
     bool
     Magma<T>::right_semimedial() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(this->at(y, z), this->at(x, x)) == this->at(this->at(y, x), this->at(z, x));
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(this->_op(y, z), this->_op(x, x)) == this->_op(this->_op(y, x), this->_op(z, x));
         });
     }
     
@@ -74,8 +81,8 @@ namespace zebra
     bool
     Magma<T>::left_distributive() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(x, this->at(y, z)) == this->at(this->at(x, y), this->at(x, z));
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(x, this->_op(y, z)) == this->_op(this->_op(x, y), this->_op(x, z));
         });
     }
     
@@ -83,8 +90,8 @@ namespace zebra
     bool
     Magma<T>::right_distributive() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(this->at(y, z), x) == this->at(this->at(y, x), this->at(z, x));
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(this->_op(y, z), x) == this->_op(this->_op(y, x), this->_op(z, x));
         });
     }
     
@@ -92,8 +99,8 @@ namespace zebra
     bool
     Magma<T>::commutative() const
     {
-        return all2(_set, [this] (auto x, auto y) -> bool {
-            return this->at(x, y) == this->at(y, x);
+        return all2_ids(_order, [this] (id_type x, id_type y) -> bool {
+            return this->_op(x, y) == this->_op(y, x);
         });
     }
     
@@ -101,8 +108,8 @@ namespace zebra
     bool
     Magma<T>::idempotent() const
     {
-        return all(_set, [this] (auto x) -> bool {
-            return this->at(x, x) == x ;
+        return all_ids(_order, [this] (id_type x) -> bool {
+            return this->_op(x, x) == x ;
         });
     }
     
@@ -110,8 +117,8 @@ namespace zebra
     bool
     Magma<T>::unipotent() const
     {
-        return all2(_set, [this] (auto x, auto y) -> bool {
-           return this->at(x, x) == this->at(y, y); 
+        return all2_ids(_order, [this] (id_type x, id_type y) -> bool {
+           return this->_op(x, x) == this->_op(y, y); 
         });
     }
     
@@ -119,9 +126,9 @@ namespace zebra
     bool
     Magma<T>::zeropotent() const
     {
-        return all2(_set, [this] (auto x, auto y) -> bool {
-            auto xx = this->at(x, x);
-            return this->at(xx, y) == xx && xx == this->at(y, xx);
+        return all2_ids(_order, [this] (id_type x, id_type y) -> bool {
+            auto xx = this->_op(x, x);
+            return this->_op(xx, y) == xx && xx == this->_op(y, xx);
         });
     }
     
@@ -129,11 +136,11 @@ namespace zebra
     bool
     Magma<T>::alternative() const
     {
-        return all2(_set, [this] (auto x, auto y) -> bool {
-            auto xx = this->at(x, x);
-            auto yy = this->at(y, y);
-            auto xy = this->at(x, y);
-            return this->at(xx, y) == this->at(x, xy) && this->at(x, yy) == this->at(xy, y);
+        return all2_ids(_order, [this] (id_type x, id_type y) -> bool {
+            auto xx = this->_op(x, x);
+            auto yy = this->_op(y, y);
+            auto xy = this->_op(x, y);
+            return this->_op(xx, y) == this->_op(x, xy) && this->_op(x, yy) == this->_op(xy, y);
         });
     }
     
@@ -141,8 +148,8 @@ namespace zebra
     bool
     Magma<T>::associative() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(this->at(x, y), z) == this->at(x, this->at(y, z));
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(this->_op(x, y), z) == this->_op(x, this->_op(y, z));
         });
     }
     
@@ -150,8 +157,8 @@ namespace zebra
     bool
     Magma<T>::left_unar() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(x, y) == this->at(x, z);
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(x, y) == this->_op(x, z);
         });
     }
     
@@ -159,8 +166,8 @@ namespace zebra
     bool
     Magma<T>::right_unar() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(y, x) == this->at(z, x);
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(y, x) == this->_op(z, x);
         });
     }
     
@@ -168,8 +175,8 @@ namespace zebra
     bool
     Magma<T>::null_semigroup() const
     {
-        return all4(_set, [this] (auto w, auto x, auto y, auto z) {
-            return this->at(w, x) == this->at(y, z);
+        return all4_ids(_order, [this] (id_type w, id_type x, id_type y, id_type z) {
+            return this->_op(w, x) == this->_op(y, z);
         });
     }
     
@@ -177,28 +184,36 @@ namespace zebra
     bool
     Magma<T>::unital() const
     {
-        T result ;
-        return identity_extract(result);
+        id_type result ;
+        return _identity_extract(result);
     }
     
     template <typename T>
     bool
     Magma<T>::identity_extract(T& element) const
     {
-        HashMap<T, bool> flagged;
-        for (auto&& i : _set)
+        id_type id ;
+        if (!_identity_extract(id))
+            return false;
+        element = _value(id);
+        return true;
+    }
+    
+    template <typename T>
+    bool
+    Magma<T>::_identity_extract(id_type& element) const
+    {
+        for (id_type i = 0; i < _order; ++i)
         {
-            flagged[i] = true ;
-            for (auto&& element : _set)
-                if (!(this->at(element, i) == element && this->at(i, element) == element))
-                    flagged[i] = false ;
-        }
-        for (auto&& i : _set)
-            if (flagged[i])
+            bool flagged = true ;
+            for (id_type x = 0; x < _order && flagged; ++x)
+                flagged = _op(x, i) == x && _op(i, x) == x ;
+            if (flagged)
             {
                 element = i ;
                 return true;
             }
+        }
         return false;
     }
     
@@ -206,8 +221,8 @@ namespace zebra
     bool
     Magma<T>::left_cancellative() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z)  -> bool {
-            return this->at(x, y) == this->at(x, z) && y == z ;
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z)  -> bool {
+            return this->_op(x, y) == this->_op(x, z) ? y == z : true ;
         });
     }
     
@@ -215,8 +230,8 @@ namespace zebra
     bool
     Magma<T>::right_cancellative() const
     {
-        return all3(_set, [this] (auto x, auto y, auto z) -> bool {
-            return this->at(y, x) == this->at(z, x) && y == z ;
+        return all3_ids(_order, [this] (id_type x, id_type y, id_type z) -> bool {
+            return this->_op(y, x) == this->_op(z, x) ? y == z : true ;
         });
     }
     
@@ -224,8 +239,8 @@ namespace zebra
     bool
     Magma<T>::left_zero_semigroup() const 
     {
-        return all2(_set, [this] (auto x, auto y)  -> bool {
-            return x == this->at(x, y);
+        return all2_ids(_order, [this] (id_type x, id_type y)  -> bool {
+            return x == this->_op(x, y);
         });
     }
     
@@ -233,11 +248,11 @@ namespace zebra
     bool
     Magma<T>::right_zero_semigroup() const 
     {
-        return all2(_set, [this] (auto x, auto y) -> bool {
-            return x == this->at(y, x);
+        return all2_ids(_order, [this] (id_type x, id_type y) -> bool {
+            return x == this->_op(y, x);
         });
     }
     
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -32,12 +32,12 @@ namespace zebra
         Mapping(evaluation_type&&, const Set<D>&, const Set<R>&);
         Mapping(evaluation_type&&, diter, diter);
         Mapping(evaluation_type&&, const Set<D>&);
-        Mapping(const Mapping<D, R>&);
+        Mapping(const SharedInterner<D>&, const SharedInterner<R>&, const std::vector<id_type>&);
         
         R at(const D& val) const ;
         R operator()(const D& val) const ;
         Mapping<R, D> inverse() const ;
-        qset_type kernel() const; 
+        Set<Set<D>> kernel() const; 
         
         using BinaryRelation<D, R>::domain ;
         using BinaryRelation<D, R>::range  ;
@@ -46,8 +46,10 @@ namespace zebra
     protected:
     
         using BinaryRelation<D, R>::_relation ;
-        using BinaryRelation<D, R>::_codomain ;
-        using BinaryRelation<D, R>::_from ;
+        using BinaryRelation<D, R>::_dsym ;
+        using BinaryRelation<D, R>::_rsym ;
+        
+        template <typename, typename> friend class BinaryRelation ;
         
     private:
         void check() throw(Exception); 
@@ -82,24 +84,24 @@ namespace zebra
                                          diter dend, 
                                          riter rstart, 
                                          riter rend)
-        : BinaryRelation<D, R>{relation, dstart, dend, rstart, rend}
+        : BinaryRelation<D, R>{std::move(relation), dstart, dend, rstart, rend}
     { check(); }
     
     template <typename D, typename R>
     Mapping<D, R>::Mapping(membership_type&& relation,
                                          diter dstart, 
                                          diter dend)
-        : BinaryRelation<D, R>{relation, dstart, dend}
+        : BinaryRelation<D, R>{std::move(relation), dstart, dend}
     { check(); }
     
     template <typename D, typename R>
     Mapping<D, R>::Mapping(membership_type&& relation, const Set<D>& from, const Set<R>& codomain)
-        : BinaryRelation<D, R>{relation, from, codomain}
+        : BinaryRelation<D, R>{std::move(relation), from, codomain}
     { check(); }
     
     template <typename D, typename R>
     Mapping<D, R>::Mapping(membership_type&& relation, const Set<D>& set)
-        : BinaryRelation<D, R>{relation, set}
+        : BinaryRelation<D, R>{std::move(relation), set}
     { check(); }
     
     template <typename D, typename R>
@@ -108,20 +110,58 @@ namespace zebra
                                          diter dend, 
                                          riter rstart, 
                                          riter rend)
-        : BinaryRelation<D, R>{relation, dstart, dend, rstart, rend}
+        : BinaryRelation<D, R>{std::move(relation), dstart, dend, rstart, rend}
     { check(); }
     
     template <typename D, typename R>
-    typename Mapping<D, R>::qset_type
+    Mapping<D, R>::Mapping(evaluation_type&& relation,
+                                         diter dstart, 
+                                         diter dend)
+        : BinaryRelation<D, R>{std::move(relation), dstart, dend}
+    { check(); }
+    
+    template <typename D, typename R>
+    Mapping<D, R>::Mapping(evaluation_type&& relation, const Set<D>& from, const Set<R>& codomain)
+        : BinaryRelation<D, R>{std::move(relation), from, codomain}
+    { check(); }
+    
+    template <typename D, typename R>
+    Mapping<D, R>::Mapping(evaluation_type&& relation, const Set<D>& set)
+        : BinaryRelation<D, R>{std::move(relation), set}
+    { check(); }
+    
+    // Dense form over existing carriers: the image of domain id x is the
+    // codomain id images[x]
+    template <typename D, typename R>
+    Mapping<D, R>::Mapping(const SharedInterner<D>& from, const SharedInterner<R>& codomain, const std::vector<id_type>& images)
+    {
+        if (images.size() != from->size())
+            throw Exception(NOT_CONFORMANT, "Images do not match the domain...");
+        _dsym = from ;
+        _rsym = codomain ;
+        rel_type relation(images.size());
+        for (id_type x = 0; x < images.size(); ++x)
+        {
+            if (images[x] >= codomain->size())
+                throw Exception(NOT_IN_CODOMAIN, "Image not in codomain...");
+            relation[x].insert(images[x]);
+        }
+        _relation = std::move(relation);
+    }
+    
+    // Fibres of the mapping, grouped by image id
+    template <typename D, typename R>
+    Set<Set<D>>
     Mapping<D, R>::kernel() const
     {
-        typename BinaryRelation<D, R>::qset_type result ;
-        auto pairs = make_pairs(domain(), [](const auto& set, const auto& first, const auto& second){ 
-            return std::find(set.cbegin(), set.cend(), Pair<D, R>(second, first)) != set.cend() && first != second ;
-        });
-        for (const auto& pair : pairs)
-            if (at(pair.first) == at(pair.second))
-                result.insert(pair);
+        std::vector<Set<D>> fibres(_rsym ? _rsym->size() : 0u);
+        for (id_type x = 0; x < _relation->size(); ++x)
+            if (!(*_relation)[x].empty())
+                fibres[*(*_relation)[x].begin()].insert((*_dsym)[x]);
+        Set<Set<D>> result ;
+        for (auto&& fibre : fibres)
+            if (!fibre.empty())
+                result.insert(fibre);
         return result;
     }
     
@@ -129,9 +169,10 @@ namespace zebra
     R
     Mapping<D, R>::at(const D& val) const 
     {
-        if (_codomain.find(val) == _codomain.cend())
-            throw Exception(DOES_NOT_EXIST, "Parameter not in codomain...");
-        return *(_relation.get(val)->cbegin());
+        auto id = _dsym ? _dsym->find(val) : npos ;
+        if (id == npos || (*_relation)[id].empty())
+            throw Exception(DOES_NOT_EXIST, "Parameter not in domain...");
+        return (*_rsym)[*(*_relation)[id].begin()];
     }
     
     template <typename D, typename R>
@@ -145,14 +186,7 @@ namespace zebra
     std::ostream& 
     operator<<(std::ostream& stream, const Mapping<A, B>& br)
     {
-        for (auto it = br.cbegin(); it != br.cend(); ++it)
-        {
-            stream << *it->first << " : [ ";
-            for (const auto& element : it->second)
-                stream << *element << " ";
-            stream << "]\n";
-        }
-        return stream ;
+        return stream << static_cast<const BinaryRelation<A, B>&>(br);
     }
     
     template <typename A, typename B> using Function = Mapping<A, B>;
@@ -2,6 +2,7 @@
 #define ZEBRA_MONOID
 
 #include "semigroup.hpp"
+#include "cayley.hpp"
 
 namespace zebra
 {
@@ -14,31 +15,42 @@ namespace zebra
         using typename SemiGroup<T>::param_type;
         using typename SemiGroup<T>::table_type;
         using typename SemiGroup<T>::iter ;
+        using typename SemiGroup<T>::cells_type ;
         using SemiGroup<T>::identity_extract ;
         
         Monoid() {}
         Monoid(const table_type&, const Set<T>&);
         Monoid(iter, iter, const Set<T>&);
         Monoid(bin_op_type&&, const Set<T>&);
+        Monoid(const cells_type&, const SharedInterner<T>&);
         
         bool trace() const ;
         bool zerosumfree() const ;
         bool inverse_monoid() const ;
         T    identity() const { return _identity; }
         
+        Closure<T, Monoid> generate(const std::vector<T>& generators) const { return Closure<T, Monoid>{*this, generators, _identity_id}; }
+        CayleyGraph<T, Monoid> cayley_graph(const std::vector<T>& generators) const { return CayleyGraph<T, Monoid>{*this, generators, _identity_id}; }
+        
     protected:
-        using SemiGroup<T>::_set ;
-        T     _identity ;      
+        using SemiGroup<T>::_order ;
+        using SemiGroup<T>::_op ;
+        using SemiGroup<T>::_value ;
+        T       _identity ;
+        id_type _identity_id ;
           
         void check() throw(Exception);
     };
+
+    template <typename T> using Submonoid = Sub<T, Monoid>;
     
     template <typename T>
     void
     Monoid<T>::check() throw(Exception)
     {
-         if (!identity_extract(_identity))
+         if (!this->_identity_extract(_identity_id))
             throw Exception(NOT_CONFORMANT, "No identity element exists...");
+         _identity = _value(_identity_id);
     }
     
     template <typename T>
@@ -61,13 +73,20 @@ namespace zebra
     {
         check();
     }
+
+    template <typename T>
+    Monoid<T>::Monoid(const cells_type& cells, const SharedInterner<T>& symbols)
+        : SemiGroup<T>{cells, symbols}
+    {
+        check();
+    }
     
     template <typename T>
     bool
     Monoid<T>::trace() const
     {
-        return !any2(_set, [this](auto x, auto y) -> bool {
-            return this->at(x, y) == this->at(y, x);
+        return !any2_ids(_order, [this](id_type x, id_type y) -> bool {
+            return this->_op(x, y) == this->_op(y, x);
         }); 
     }
 }
@@ -0,0 +1,547 @@
+#ifndef ZEBRA_PERMUTATION
+#define ZEBRA_PERMUTATION
+
+#include "group.hpp"
+#include <random>
+
+namespace zebra
+{
+    // A permutation of the points [0, degree()), stored as its images.
+    // Products compose left to right, x^(pq) = (x^p)^q, i.e. (p * q)[x] is
+    // q[p[x]], so permutations act on points from the right.
+    class Permutation
+    {
+    public:
+
+        Permutation() {}
+        explicit Permutation(std::size_t degree);
+        Permutation(std::vector<id_type>);
+        Permutation(std::initializer_list<id_type> images) : Permutation{std::vector<id_type>(images)} {}
+
+        static Permutation cycles(std::size_t, const std::vector<std::vector<id_type>>&);
+
+        std::size_t                 degree() const { return _images.size(); }
+        id_type                     operator[](id_type x) const { return _images[x]; }
+        id_type                     at(id_type x) const ;
+        const std::vector<id_type>& images() const { return _images; }
+        bool                        trivial() const ;
+        id_type                     moved() const ;
+        Permutation                 inverse() const ;
+        uint64_t                    order() const ;
+        std::size_t                 hash() const ;
+        Mapping<id_type, id_type>   mapping() const ;
+
+        Permutation& operator*=(const Permutation& rhs) { return *this = *this * rhs; }
+        friend Permutation operator*(const Permutation&, const Permutation&);
+
+        bool operator==(const Permutation& rhs) const { return _images == rhs._images; }
+        bool operator!=(const Permutation& rhs) const { return _images != rhs._images; }
+
+        friend std::ostream& operator<<(std::ostream&, const Permutation&);
+
+    protected:
+
+        std::vector<id_type> _images ;
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<zebra::Permutation>
+    {
+        size_t operator()(const zebra::Permutation& perm) const { return perm.hash(); }
+    };
+
+    CREATE_SET_KEYS(zebra::Permutation, hash);
+}
+
+namespace zebra
+{
+    inline
+    Permutation::Permutation(std::size_t degree)
+        : _images(degree)
+    {
+        for (id_type x = 0; x < degree; ++x)
+            _images[x] = x ;
+    }
+
+    inline
+    Permutation::Permutation(std::vector<id_type> images)
+        : _images{std::move(images)}
+    {
+        std::vector<bool> hit(_images.size(), false);
+        for (auto&& y : _images)
+        {
+            if (y >= _images.size() || hit[y])
+                throw Exception(NOT_CONFORMANT, "Images do not form a permutation...");
+            hit[y] = true ;
+        }
+    }
+
+    inline Permutation
+    Permutation::cycles(std::size_t degree, const std::vector<std::vector<id_type>>& cycles)
+    {
+        Permutation result(degree);
+        for (auto&& cycle : cycles)
+            for (std::size_t i = 0; i < cycle.size(); ++i)
+            {
+                if (cycle[i] >= degree)
+                    throw Exception(NOT_CONFORMANT, "Cycle point outside the degree...");
+                result._images[cycle[i]] = cycle[(i + 1) % cycle.size()];
+            }
+        return Permutation{result._images};
+    }
+
+    inline id_type
+    Permutation::at(id_type x) const
+    {
+        if (x >= _images.size())
+            throw Exception(DOES_NOT_EXIST, "Point outside the degree...");
+        return _images[x];
+    }
+
+    inline bool
+    Permutation::trivial() const
+    {
+        return moved() == npos ;
+    }
+
+    // First point that is not fixed, npos for the identity
+    inline id_type
+    Permutation::moved() const
+    {
+        for (id_type x = 0; x < _images.size(); ++x)
+            if (_images[x] != x)
+                return x ;
+        return npos ;
+    }
+
+    inline Permutation
+    Permutation::inverse() const
+    {
+        Permutation result(degree());
+        for (id_type x = 0; x < _images.size(); ++x)
+            result._images[_images[x]] = x ;
+        return result ;
+    }
+
+    // Least common multiple of the cycle lengths
+    inline uint64_t
+    Permutation::order() const
+    {
+        uint64_t result = 1u ;
+        std::vector<bool> seen(_images.size(), false);
+        for (id_type x = 0; x < _images.size(); ++x)
+            if (!seen[x])
+            {
+                uint64_t length = 0u ;
+                for (id_type y = x; !seen[y]; y = _images[y], ++length)
+                    seen[y] = true ;
+                uint64_t a = result, b = length ;
+                while (b)
+                {
+                    auto t = a % b ;
+                    a = b ;
+                    b = t ;
+                }
+                result = result / a * length ;
+            }
+        return result ;
+    }
+
+    inline std::size_t
+    Permutation::hash() const
+    {
+        std::size_t result = _images.size();
+        for (auto&& y : _images)
+            result ^= std::hash<id_type>()(y) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+        return result ;
+    }
+
+    inline Mapping<id_type, id_type>
+    Permutation::mapping() const
+    {
+        Set<id_type> points ;
+        for (id_type x = 0; x < _images.size(); ++x)
+            points.insert(x);
+        auto images = _images ;
+        return Mapping<id_type, id_type>{[images](id_type x) { return images[x]; }, points};
+    }
+
+    inline Permutation
+    operator*(const Permutation& lhs, const Permutation& rhs)
+    {
+        if (lhs.degree() != rhs.degree())
+            throw Exception(NOT_CONFORMANT, "Permutations of different degrees...");
+        Permutation result(lhs.degree());
+        for (id_type x = 0; x < lhs._images.size(); ++x)
+            result._images[x] = rhs._images[lhs._images[x]];
+        return result ;
+    }
+
+    // Cycle notation, fixed points omitted
+    inline std::ostream&
+    operator<<(std::ostream& stream, const Permutation& perm)
+    {
+        std::vector<bool> seen(perm.degree(), false);
+        bool any = false ;
+        for (id_type x = 0; x < perm.degree(); ++x)
+            if (!seen[x] && perm[x] != x)
+            {
+                any = true ;
+                stream << "(" << x ;
+                seen[x] = true ;
+                for (id_type y = perm[x]; y != x; y = perm[y])
+                {
+                    stream << " " << y ;
+                    seen[y] = true ;
+                }
+                stream << ")";
+            }
+        if (!any)
+            stream << "()";
+        return stream ;
+    }
+
+    // A group of permutations given by generators. Schreier-Sims computes a
+    // base b_0, ..., b_k-1 and a strong generating set: level i holds the
+    // generators fixing b_0, ..., b_i-1 together with the orbit of b_i and
+    // a transversal u_x mapping b_i to every x of that orbit. Every element
+    // factors uniquely as u_k-1 ... u_0, which gives order, membership by
+    // sifting and uniform random elements without ever listing the group.
+    class PermutationGroup
+    {
+    public:
+
+        typedef Permutation element_type ;
+
+        PermutationGroup() {}
+        PermutationGroup(std::size_t, const std::vector<Permutation>&, const std::vector<id_type>& = {});
+
+        std::size_t              degree() const { return _degree; }
+        const std::vector<Permutation>& generators() const { return _generators; }
+        Permutation              identity() const { return Permutation(_degree); }
+        uint64_t                 order() const ;
+        bool                     contains(const Permutation&) const ;
+        bool                     trivial() const { return _levels.empty(); }
+        std::vector<id_type>     base() const ;
+        std::vector<Permutation> strong_generators() const ;
+        std::vector<std::size_t> basic_orbit_lengths() const ;
+        std::vector<id_type>     orbit(id_type) const ;
+        PermutationGroup         stabilizer(std::size_t) const ;
+        PermutationGroup         point_stabilizer(id_type) const ;
+        std::vector<Permutation> elements() const ;
+        Group<Permutation>       to_group() const ;
+        GroupAction<Permutation, id_type> natural_action() const ;
+
+        template <typename E> Permutation random(E&) const ;
+
+    protected:
+
+        struct Level
+        {
+            id_type                  point ;
+            std::vector<Permutation> generators ;
+            std::vector<id_type>     orbit ;
+            std::vector<Permutation> transversal ;
+        };
+
+        bool        _in_orbit(const Level& level, id_type x) const { return level.transversal[x].degree() != 0u; }
+        void        _orbit(Level&) const ;
+        std::size_t _sift(Permutation&, std::size_t) const ;
+        void        _schreier_sims(const std::vector<id_type>&);
+
+        std::size_t              _degree = 0u ;
+        std::vector<Permutation> _generators ;
+        std::vector<Level>       _levels ;
+    };
+
+    inline
+    PermutationGroup::PermutationGroup(std::size_t degree, const std::vector<Permutation>& generators, const std::vector<id_type>& prefix)
+        : _degree{degree}
+    {
+        for (auto&& generator : generators)
+        {
+            if (generator.degree() != degree)
+                throw Exception(NOT_CONFORMANT, "Generator of a different degree...");
+            if (!generator.trivial())
+                _generators.push_back(generator);
+        }
+        for (auto&& point : prefix)
+            if (point >= degree)
+                throw Exception(NOT_CONFORMANT, "Base point outside the degree...");
+        _schreier_sims(prefix);
+    }
+
+    // Breadth first from the base point, u_y = u_x s for y = x^s
+    inline void
+    PermutationGroup::_orbit(Level& level) const
+    {
+        level.orbit.assign(1u, level.point);
+        level.transversal.assign(_degree, Permutation{});
+        level.transversal[level.point] = Permutation(_degree);
+        for (std::size_t i = 0; i < level.orbit.size(); ++i)
+        {
+            auto x = level.orbit[i];
+            for (auto&& s : level.generators)
+                if (!_in_orbit(level, s[x]))
+                {
+                    level.transversal[s[x]] = level.transversal[x] * s ;
+                    level.orbit.push_back(s[x]);
+                }
+        }
+    }
+
+    // Strips g down the chain from the given level, g becomes the residue
+    // and the level where sifting stopped is returned (size when it passed)
+    inline std::size_t
+    PermutationGroup::_sift(Permutation& g, std::size_t from) const
+    {
+        for (std::size_t i = from; i < _levels.size(); ++i)
+        {
+            auto x = g[_levels[i].point];
+            if (!_in_orbit(_levels[i], x))
+                return i ;
+            g *= _levels[i].transversal[x].inverse();
+        }
+        return _levels.size();
+    }
+
+    // Deterministic Schreier-Sims: every Schreier generator u_x s u_x^s^-1
+    // of every level is sifted through the deeper levels, a non trivial
+    // residue is added as a strong generator and the scan resumes there
+    inline void
+    PermutationGroup::_schreier_sims(const std::vector<id_type>& prefix)
+    {
+        _levels.clear();
+        for (auto&& point : prefix)
+        {
+            Level level ;
+            level.point = point ;
+            _levels.push_back(level);
+        }
+        for (auto&& g : _generators)
+        {
+            bool fixes = true ;
+            for (auto&& level : _levels)
+                fixes = fixes && g[level.point] == level.point ;
+            if (fixes)
+            {
+                Level level ;
+                level.point = g.moved();
+                _levels.push_back(level);
+            }
+        }
+        for (std::size_t i = 0; i < _levels.size(); ++i)
+        {
+            for (auto&& g : _generators)
+            {
+                bool fixes = true ;
+                for (std::size_t j = 0; j < i; ++j)
+                    fixes = fixes && g[_levels[j].point] == _levels[j].point ;
+                if (fixes)
+                    _levels[i].generators.push_back(g);
+            }
+            _orbit(_levels[i]);
+        }
+        std::size_t i = _levels.size();
+        while (i > 0)
+        {
+            auto& level = _levels[i - 1];
+            bool restart = false ;
+            for (std::size_t o = 0; !restart && o < level.orbit.size(); ++o)
+                for (std::size_t s = 0; !restart && s < level.generators.size(); ++s)
+                {
+                    auto x = level.orbit[o];
+                    auto& gen = level.generators[s];
+                    Permutation h = level.transversal[x] * gen * level.transversal[gen[x]].inverse();
+                    if (h.trivial())
+                        continue ;
+                    auto j = _sift(h, i);
+                    if (h.trivial())
+                        continue ;
+                    if (j == _levels.size())
+                    {
+                        Level deeper ;
+                        deeper.point = h.moved();
+                        _levels.push_back(deeper);
+                    }
+                    for (std::size_t l = i; l <= j; ++l)
+                    {
+                        _levels[l].generators.push_back(h);
+                        _orbit(_levels[l]);
+                    }
+                    i = j + 1 ;
+                    restart = true ;
+                }
+            if (!restart)
+                --i ;
+        }
+        // Prefix points whose orbit is trivial carry no information
+        std::vector<Level> levels ;
+        for (auto&& level : _levels)
+            if (level.orbit.size() > 1u)
+                levels.push_back(std::move(level));
+        _levels = std::move(levels);
+    }
+
+    inline uint64_t
+    PermutationGroup::order() const
+    {
+        uint64_t result = 1u ;
+        for (auto&& level : _levels)
+        {
+            if (result > std::numeric_limits<uint64_t>::max() / level.orbit.size())
+                throw Exception(NOT_CONFORMANT, "Order does not fit in 64 bits...");
+            result *= level.orbit.size();
+        }
+        return result ;
+    }
+
+    inline bool
+    PermutationGroup::contains(const Permutation& g) const
+    {
+        if (g.degree() != _degree)
+            return false ;
+        Permutation residue = g ;
+        return _sift(residue, 0u) == _levels.size() && residue.trivial();
+    }
+
+    inline std::vector<id_type>
+    PermutationGroup::base() const
+    {
+        std::vector<id_type> result ;
+        for (auto&& level : _levels)
+            result.push_back(level.point);
+        return result ;
+    }
+
+    inline std::vector<Permutation>
+    PermutationGroup::strong_generators() const
+    {
+        std::vector<Permutation> result ;
+        Set<Permutation> seen ;
+        for (auto&& level : _levels)
+            for (auto&& g : level.generators)
+                if (seen.insert(g).second)
+                    result.push_back(g);
+        return result ;
+    }
+
+    inline std::vector<std::size_t>
+    PermutationGroup::basic_orbit_lengths() const
+    {
+        std::vector<std::size_t> result ;
+        for (auto&& level : _levels)
+            result.push_back(level.orbit.size());
+        return result ;
+    }
+
+    inline std::vector<id_type>
+    PermutationGroup::orbit(id_type point) const
+    {
+        if (point >= _degree)
+            throw Exception(DOES_NOT_EXIST, "Point outside the degree...");
+        std::vector<bool> seen(_degree, false);
+        std::vector<id_type> result(1u, point);
+        seen[point] = true ;
+        for (std::size_t i = 0; i < result.size(); ++i)
+            for (auto&& g : _generators)
+                if (!seen[g[result[i]]])
+                {
+                    seen[g[result[i]]] = true ;
+                    result.push_back(g[result[i]]);
+                }
+        return result ;
+    }
+
+    // The pointwise stabiliser of the first depth base points, read off the
+    // chain without running Schreier-Sims again
+    inline PermutationGroup
+    PermutationGroup::stabilizer(std::size_t depth) const
+    {
+        PermutationGroup result ;
+        result._degree = _degree ;
+        if (depth < _levels.size())
+        {
+            result._generators = _levels[depth].generators ;
+            result._levels.assign(_levels.begin() + depth, _levels.end());
+        }
+        return result ;
+    }
+
+    inline PermutationGroup
+    PermutationGroup::point_stabilizer(id_type point) const
+    {
+        if (point >= _degree)
+            throw Exception(DOES_NOT_EXIST, "Point outside the degree...");
+        PermutationGroup rebased(_degree, strong_generators(), std::vector<id_type>(1u, point));
+        return !rebased._levels.empty() && rebased._levels.front().point == point ? rebased.stabilizer(1u) : rebased ;
+    }
+
+    // Every product u_k-1 ... u_0, one per element
+    inline std::vector<Permutation>
+    PermutationGroup::elements() const
+    {
+        std::vector<Permutation> result(1u, identity());
+        for (std::size_t i = _levels.size(); i > 0; --i)
+        {
+            std::vector<Permutation> next ;
+            next.reserve(result.size() * _levels[i - 1].orbit.size());
+            for (auto&& g : result)
+                for (auto&& x : _levels[i - 1].orbit)
+                    next.push_back(g * _levels[i - 1].transversal[x]);
+            result = std::move(next);
+        }
+        return result ;
+    }
+
+    // Tabulates the group, |G|^2 ids, for the table based algorithms. The
+    // elements are closed under composition, so the table is not checked
+    inline Group<Permutation>
+    PermutationGroup::to_group() const
+    {
+        if (order() >= npos)
+            throw Exception(NOT_CONFORMANT, "Group too large to tabulate...");
+        auto elements = this->elements();
+        auto symbols = std::make_shared<Interner<Permutation>>(elements.cbegin(), elements.cend());
+        id_type n = static_cast<id_type>(symbols->size());
+        Group<Permutation>::cells_type cells(static_cast<std::size_t>(n) * n);
+        for (id_type x = 0; x < n; ++x)
+            for (id_type y = 0; y < n; ++y)
+                cells[static_cast<std::size_t>(x) * n + y] = symbols->id((*symbols)[x] * (*symbols)[y]);
+        std::vector<id_type> inverse(n);
+        for (id_type x = 0; x < n; ++x)
+            inverse[x] = symbols->id((*symbols)[x].inverse());
+        return Group<Permutation>{cells, symbols, symbols->id(identity()), inverse};
+    }
+
+    inline GroupAction<Permutation, id_type>
+    PermutationGroup::natural_action() const
+    {
+        Set<id_type> points ;
+        for (id_type x = 0; x < _degree; ++x)
+            points.insert(x);
+        return GroupAction<Permutation, id_type>{to_group(), points,
+            [](Permutation g, id_type x) { return g[x]; }, GroupAction<Permutation, id_type>::RightAction};
+    }
+
+    // Uniform, one transversal element drawn per level
+    template <typename E>
+    Permutation
+    PermutationGroup::random(E& engine) const
+    {
+        Permutation result = identity();
+        for (std::size_t i = _levels.size(); i > 0; --i)
+        {
+            std::uniform_int_distribution<std::size_t> pick(0u, _levels[i - 1].orbit.size() - 1u);
+            result *= _levels[i - 1].transversal[_levels[i - 1].orbit[pick(engine)]];
+        }
+        return result ;
+    }
+}
+
+#include "automorphism.hpp"
+
+#endif
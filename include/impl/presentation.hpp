@@ -0,0 +1,445 @@
+#ifndef ZEBRA_PRESENTATION
+#define ZEBRA_PRESENTATION
+
+#include "permutation.hpp"
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+
+namespace zebra
+{
+    // A finite presentation <x_0, ..., x_k-1 | relators>. Words are lists of
+    // letters, i + 1 standing for x_i and -(i + 1) for its inverse. parse()
+    // reads the usual shorthand, a lower case letter for a generator, the
+    // upper case one for its inverse and ^n for a power: "a^5", "b^2",
+    // "abab" or "ABab".
+    class Presentation
+    {
+    public:
+        typedef std::vector<int> word_type ;
+
+        Presentation() {}
+        Presentation(std::size_t, std::vector<word_type>);
+        Presentation(std::size_t, const std::vector<std::string>&);
+
+        static word_type parse(const std::string&);
+        static word_type power(const word_type&, std::size_t);
+        static word_type inverse(const word_type&);
+
+        std::size_t                   generators() const { return _generators; }
+        const std::vector<word_type>& relators() const { return _relators; }
+
+    protected:
+
+        std::size_t            _generators = 0u ;
+        std::vector<word_type> _relators ;
+    };
+
+    inline
+    Presentation::Presentation(std::size_t generators, std::vector<word_type> relators)
+        : _generators{generators}, _relators{std::move(relators)}
+    {
+        for (auto&& relator : _relators)
+            for (auto&& letter : relator)
+                if (letter == 0 || static_cast<std::size_t>(std::abs(letter)) > generators)
+                    throw Exception(NOT_CONFORMANT, "Relator uses an unknown generator...");
+    }
+
+    inline
+    Presentation::Presentation(std::size_t generators, const std::vector<std::string>& relators)
+    {
+        std::vector<word_type> words ;
+        for (auto&& relator : relators)
+            words.push_back(parse(relator));
+        *this = Presentation{generators, std::move(words)};
+    }
+
+    inline Presentation::word_type
+    Presentation::parse(const std::string& text)
+    {
+        word_type result ;
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            auto c = text[i];
+            if (c == '^' && !result.empty())
+            {
+                std::size_t n = 0u ;
+                for (; i + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[i + 1])); ++i)
+                    n = n * 10u + static_cast<std::size_t>(text[i + 1] - '0');
+                result.insert(result.end(), n == 0u ? 0u : n - 1u, result.back());
+                if (n == 0u)
+                    result.pop_back();
+            }
+            else if (c >= 'a' && c <= 'z')
+                result.push_back(c - 'a' + 1);
+            else if (c >= 'A' && c <= 'Z')
+                result.push_back(-(c - 'A' + 1));
+            else if (c != ' ')
+                throw Exception(NOT_CONFORMANT, "Unexpected character in a word...");
+        }
+        return result ;
+    }
+
+    inline Presentation::word_type
+    Presentation::power(const word_type& word, std::size_t n)
+    {
+        word_type result ;
+        result.reserve(word.size() * n);
+        for (std::size_t i = 0; i < n; ++i)
+            result.insert(result.end(), word.cbegin(), word.cend());
+        return result ;
+    }
+
+    inline Presentation::word_type
+    Presentation::inverse(const word_type& word)
+    {
+        word_type result(word.rbegin(), word.rend());
+        for (auto&& letter : result)
+            letter = -letter ;
+        return result ;
+    }
+
+    // Todd-Coxeter coset enumeration, HLT strategy, of the cosets of the
+    // subgroup generated by some words. The coset table has a column per
+    // generator and one per inverse. Every live coset in turn has all
+    // relators scanned from it, undefined entries being defined on the way,
+    // and then its row completed. Coincidences are merged eagerly with a
+    // union-find forwarding array. When the table is about to outgrow the
+    // coset budget a lookahead pass scans every relator from every coset
+    // without defining anything, which only ever merges, and the table is
+    // compacted. If that does not free enough rows, or the time budget
+    // runs out, the enumeration stops with LIMIT_EXCEEDED.
+    class CosetEnumeration
+    {
+    public:
+        typedef Presentation::word_type word_type ;
+
+        CosetEnumeration() {}
+        CosetEnumeration(const Presentation&, const std::vector<word_type>& = {},
+                         std::size_t = std::size_t(1) << 22, std::chrono::milliseconds = std::chrono::milliseconds{0});
+
+        std::size_t                 index() const { return _size; }
+        std::size_t                 columns() const { return _columns; }
+        const std::vector<id_type>& table() const { return _table; }
+        id_type                     act(id_type c, std::size_t generator) const { return _entry(c, 2u * generator); }
+        id_type                     act(id_type, const word_type&) const ;
+
+        std::vector<Permutation> permutations() const ;
+        PermutationGroup         permutation_group() const ;
+        Group<id_type>           group() const ;
+
+    protected:
+
+        id_type& _entry(id_type c, std::size_t x) { return _table[static_cast<std::size_t>(c) * _columns + x]; }
+        id_type  _entry(id_type c, std::size_t x) const { return _table[static_cast<std::size_t>(c) * _columns + x]; }
+        static std::size_t _column(int letter) { return letter > 0 ? 2u * (letter - 1) : 2u * (-letter - 1) + 1u; }
+        static std::size_t _inverse(std::size_t x) { return x ^ 1u; }
+
+        std::vector<std::size_t> _columns_of(const word_type&) const ;
+        bool    _alive(id_type c) const { return _forward[c] == c; }
+        id_type _find(id_type);
+        void    _define(id_type, std::size_t);
+        bool    _scan(id_type, const std::vector<std::size_t>&, bool);
+        void    _merge(id_type, id_type, std::vector<id_type>&);
+        void    _coincidence(id_type, id_type);
+        void    _lookahead();
+        id_type _compact(id_type);
+
+        std::size_t                           _columns = 0u ;
+        std::size_t                           _size = 0u ;
+        std::vector<id_type>                  _table ;
+        std::vector<id_type>                  _forward ;
+        std::vector<std::vector<std::size_t>> _relators ;
+        bool                                  _subgroup = false ;
+    };
+
+    inline
+    CosetEnumeration::CosetEnumeration(const Presentation& presentation, const std::vector<word_type>& subgroup,
+                                       std::size_t limit, std::chrono::milliseconds budget)
+        : _columns{2u * presentation.generators()}
+    {
+        auto deadline = std::chrono::steady_clock::now() + budget ;
+        for (auto&& relator : presentation.relators())
+            _relators.push_back(_columns_of(relator));
+        // Room needed to process one coset: every relator may define a coset
+        // per letter, and the row itself up to one per column
+        std::size_t margin = _columns ;
+        for (auto&& relator : _relators)
+            margin += relator.size();
+        if (limit <= margin)
+            throw Exception(LIMIT_EXCEEDED, "The coset budget is too small for the relators...");
+
+        _table.assign(_columns, npos);
+        _forward.assign(1u, 0u);
+        _size = 1u ;
+        for (auto&& word : subgroup)
+        {
+            _subgroup = _subgroup || !word.empty();
+            _scan(0u, _columns_of(word), true);
+        }
+
+        for (id_type c = 0; c < _size; ++c)
+        {
+            if (_size + margin > limit)
+            {
+                _lookahead();
+                c = _compact(c);
+                if (_size + margin > limit)
+                    throw Exception(LIMIT_EXCEEDED, "Coset enumeration exceeded its coset budget...");
+                if (c >= _size)
+                    break ;
+            }
+            if (budget.count() > 0 && std::chrono::steady_clock::now() > deadline)
+                throw Exception(LIMIT_EXCEEDED, "Coset enumeration exceeded its time budget...");
+            if (!_alive(c))
+                continue ;
+            for (auto&& relator : _relators)
+                if (!_scan(c, relator, true) || !_alive(c))
+                    break ;
+            for (std::size_t x = 0; x < _columns && _alive(c); ++x)
+                if (_entry(c, x) == npos)
+                    _define(c, x);
+        }
+        _compact(0u);
+    }
+
+    inline std::vector<std::size_t>
+    CosetEnumeration::_columns_of(const word_type& word) const
+    {
+        std::vector<std::size_t> result ;
+        for (auto&& letter : word)
+        {
+            if (letter == 0 || _column(letter) >= _columns)
+                throw Exception(NOT_CONFORMANT, "Word uses an unknown generator...");
+            result.push_back(_column(letter));
+        }
+        return result ;
+    }
+
+    inline id_type
+    CosetEnumeration::_find(id_type c)
+    {
+        auto root = c ;
+        while (_forward[root] != root)
+            root = _forward[root];
+        while (_forward[c] != root)
+        {
+            auto next = _forward[c];
+            _forward[c] = root ;
+            c = next ;
+        }
+        return root ;
+    }
+
+    inline void
+    CosetEnumeration::_define(id_type c, std::size_t x)
+    {
+        auto d = static_cast<id_type>(_size++);
+        _table.resize(_size * _columns, npos);
+        _forward.push_back(d);
+        _entry(c, x) = d ;
+        _entry(d, _inverse(x)) = c ;
+    }
+
+    // Scans the word from c forwards and backwards. With fill set the gap
+    // is bridged by new cosets, otherwise the scan stops at the gap. A gap
+    // of one letter yields a deduction, a closed cycle a coincidence.
+    // Returns false when c itself was merged away.
+    inline bool
+    CosetEnumeration::_scan(id_type c, const std::vector<std::size_t>& word, bool fill)
+    {
+        if (word.empty())
+            return true ;
+        id_type f = c, b = c ;
+        std::ptrdiff_t i = 0, j = static_cast<std::ptrdiff_t>(word.size()) - 1 ;
+        while (true)
+        {
+            while (i <= j && _entry(f, word[i]) != npos)
+                f = _entry(f, word[i++]);
+            if (i > j)
+            {
+                if (f != b)
+                    _coincidence(f, b);
+                return _alive(c);
+            }
+            while (j >= i && _entry(b, _inverse(word[j])) != npos)
+                b = _entry(b, _inverse(word[j--]));
+            if (j < i)
+            {
+                _coincidence(f, b);
+                return _alive(c);
+            }
+            if (i == j)
+            {
+                _entry(f, word[i]) = b ;
+                _entry(b, _inverse(word[i])) = f ;
+                return true ;
+            }
+            if (!fill)
+                return true ;
+            _define(f, word[i]);
+        }
+    }
+
+    inline void
+    CosetEnumeration::_merge(id_type k, id_type l, std::vector<id_type>& queue)
+    {
+        k = _find(k);
+        l = _find(l);
+        if (k == l)
+            return ;
+        if (l < k)
+            std::swap(k, l);
+        _forward[l] = k ;
+        queue.push_back(l);
+    }
+
+    // Holt's coincidence procedure: the row of every coset merged away is
+    // moved onto its representative, entries already there merge in turn
+    inline void
+    CosetEnumeration::_coincidence(id_type a, id_type b)
+    {
+        std::vector<id_type> queue ;
+        _merge(a, b, queue);
+        for (std::size_t i = 0; i < queue.size(); ++i)
+        {
+            auto e = queue[i];
+            for (std::size_t x = 0; x < _columns; ++x)
+            {
+                auto f = _entry(e, x);
+                if (f == npos)
+                    continue ;
+                if (_entry(f, _inverse(x)) == e)
+                    _entry(f, _inverse(x)) = npos ;
+                auto e1 = _find(e), f1 = _find(f);
+                if (_entry(e1, x) != npos)
+                    _merge(f1, _entry(e1, x), queue);
+                else if (_entry(f1, _inverse(x)) != npos)
+                    _merge(e1, _entry(f1, _inverse(x)), queue);
+                else
+                {
+                    _entry(e1, x) = f1 ;
+                    _entry(f1, _inverse(x)) = e1 ;
+                }
+            }
+        }
+    }
+
+    inline void
+    CosetEnumeration::_lookahead()
+    {
+        for (id_type c = 0; c < _size; ++c)
+            for (auto&& relator : _relators)
+                if (!_alive(c) || !_scan(c, relator, false))
+                    break ;
+    }
+
+    // Renumbers the live cosets densely, keeping their order, and returns
+    // the new number of the first live coset at or after c
+    inline id_type
+    CosetEnumeration::_compact(id_type c)
+    {
+        std::vector<id_type> renumber(_size, npos);
+        id_type live = 0u, next = npos ;
+        for (id_type d = 0; d < _size; ++d)
+            if (_alive(d))
+            {
+                if (d >= c && next == npos)
+                    next = live ;
+                renumber[d] = live++ ;
+            }
+        std::vector<id_type> table(static_cast<std::size_t>(live) * _columns, npos);
+        for (id_type d = 0; d < _size; ++d)
+            if (_alive(d))
+                for (std::size_t x = 0; x < _columns; ++x)
+                {
+                    auto e = _entry(d, x);
+                    table[static_cast<std::size_t>(renumber[d]) * _columns + x] = e == npos ? npos : renumber[_find(e)];
+                }
+        _table = std::move(table);
+        _size = live ;
+        _forward.resize(live);
+        for (id_type d = 0; d < live; ++d)
+            _forward[d] = d ;
+        return next == npos ? live : next ;
+    }
+
+    inline id_type
+    CosetEnumeration::act(id_type c, const word_type& word) const
+    {
+        for (auto&& x : _columns_of(word))
+            c = _entry(c, x);
+        return c ;
+    }
+
+    // Generator i acts on the cosets from the right, Hw -> Hwx_i
+    inline std::vector<Permutation>
+    CosetEnumeration::permutations() const
+    {
+        std::vector<Permutation> result ;
+        for (std::size_t x = 0; x < _columns; x += 2u)
+        {
+            std::vector<id_type> images(_size);
+            for (id_type c = 0; c < _size; ++c)
+                images[c] = _entry(c, x);
+            result.push_back(Permutation{std::move(images)});
+        }
+        return result ;
+    }
+
+    inline PermutationGroup
+    CosetEnumeration::permutation_group() const
+    {
+        return PermutationGroup{_size, permutations()};
+    }
+
+    // Over the trivial subgroup the cosets are the elements. Coset d is
+    // reached from coset 0 along a spanning tree, d = parent(d) x, so the
+    // product c d is the entry of c parent(d) in column x. Filling the
+    // columns of the table in tree order costs O(n^2) lookups. A complete
+    // enumeration is the regular representation of the group, so the table
+    // is handed over unchecked, with coset 0 as the identity.
+    inline Group<id_type>
+    CosetEnumeration::group() const
+    {
+        if (_subgroup)
+            throw Exception(NOT_CONFORMANT, "Cosets of a nontrivial subgroup do not form the group...");
+        auto n = static_cast<id_type>(_size);
+        std::vector<id_type> order(1u, 0u), parent(n, npos), via(n, npos);
+        std::vector<bool> seen(n, false);
+        seen[0] = true ;
+        for (std::size_t k = 0; k < order.size(); ++k)
+            for (std::size_t x = 0; x < _columns; ++x)
+            {
+                auto d = _entry(order[k], x);
+                if (!seen[d])
+                {
+                    seen[d] = true ;
+                    parent[d] = order[k];
+                    via[d] = static_cast<id_type>(x);
+                    order.push_back(d);
+                }
+            }
+        Group<id_type>::cells_type cells(static_cast<std::size_t>(n) * n);
+        for (id_type c = 0; c < n; ++c)
+            cells[static_cast<std::size_t>(c) * n] = c ;
+        for (std::size_t k = 1; k < order.size(); ++k)
+        {
+            auto d = order[k];
+            for (id_type c = 0; c < n; ++c)
+                cells[static_cast<std::size_t>(c) * n + d] = _entry(cells[static_cast<std::size_t>(c) * n + parent[d]], via[d]);
+        }
+        auto symbols = std::make_shared<Interner<id_type>>();
+        symbols->reserve(n);
+        for (id_type c = 0; c < n; ++c)
+            symbols->intern(c);
+        std::vector<id_type> inverse(n, npos);
+        for (id_type c = 0; c < n; ++c)
+            for (id_type d = 0; d < n && inverse[c] == npos; ++d)
+                if (cells[static_cast<std::size_t>(c) * n + d] == 0)
+                    inverse[c] = d ;
+        return Group<id_type>{cells, symbols, 0, inverse};
+    }
+}
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef ZEBRA_PRODUCT
+#define ZEBRA_PRODUCT
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // The semidirect product N x| H of two finite groups for an action of H
+    // on N by automorphisms, phi_h(n). Nothing of size |N||H| is stored:
+    // the pair of ids (n, h) is encoded as n |H| + h and products are
+    // worked out on demand from the two factor tables,
+    //
+    //     (n1, h1)(n2, h2) = (n1 phi_h1(n2), h1 h2)
+    //
+    // The action is kept as an |H| x |N| table of ids, empty when trivial,
+    // which is the direct product.
+    template <typename A, typename B>
+    class SemidirectProduct
+    {
+    public:
+        typedef Pair<A, B> value_type ;
+        typedef typename std::conditional<
+            std::is_arithmetic<A>::value && std::is_arithmetic<B>::value,
+            std::function<A(B, A)>,
+            std::function<A(const B&, const A&)>>::type action_type;
+
+        SemidirectProduct() {}
+        SemidirectProduct(const Group<A>&, const Group<B>&, action_type&&);
+
+        const Group<A>& normal_factor() const { return _normal; }
+        const Group<B>& complement() const { return _complement; }
+        bool            direct() const { return _action.empty(); }
+        uint64_t        order() const { return static_cast<uint64_t>(_n) * _h; }
+
+        id_type         encode(id_type n, id_type h) const { return n * _h + h; }
+        id_type         left(id_type x) const { return x / _h; }
+        id_type         right(id_type x) const { return x % _h; }
+        id_type         id(const value_type&) const ;
+        value_type      value(id_type) const ;
+        id_type         multiply(id_type, id_type) const ;
+        id_type         invert(id_type) const ;
+        id_type         power(id_type, int64_t) const ;
+        id_type         identity_id() const { return encode(_normal_identity, _complement_identity); }
+
+        bool            contains(const value_type&) const ;
+        value_type      at(const value_type& x, const value_type& y) const { return value(multiply(id(x), id(y))); }
+        value_type      operator()(const value_type& x, const value_type& y) const { return at(x, y); }
+        value_type      identity() const { return value(identity_id()); }
+        value_type      inverse(const value_type& x) const { return value(invert(id(x))); }
+        value_type      pow(const value_type& x, int64_t k) const { return value(power(id(x), k)); }
+        uint64_t        order(const value_type&) const ;
+        Group<value_type> materialize() const ;
+
+    protected:
+
+        SemidirectProduct(const Group<A>&, const Group<B>&);
+
+        id_type _act(id_type h, id_type n) const { return _action.empty() ? n : _action[static_cast<std::size_t>(h) * _n + n]; }
+        id_type _nop(id_type x, id_type y) const { return _normal.cells()[static_cast<std::size_t>(x) * _n + y]; }
+        id_type _hop(id_type x, id_type y) const { return _complement.cells()[static_cast<std::size_t>(x) * _h + y]; }
+
+        Group<A>             _normal ;
+        Group<B>             _complement ;
+        id_type              _n = 0, _h = 0 ;
+        id_type              _normal_identity = 0, _complement_identity = 0 ;
+        std::vector<id_type> _action ;
+    };
+
+    // The direct product N x H, the semidirect product for the trivial action
+    template <typename A, typename B>
+    class DirectProduct : public SemidirectProduct<A, B>
+    {
+    public:
+        typedef typename SemidirectProduct<A, B>::value_type value_type ;
+
+        DirectProduct() {}
+        DirectProduct(const Group<A>& lhs, const Group<B>& rhs) : SemidirectProduct<A, B>{lhs, rhs} {}
+
+        uint64_t order() const { return SemidirectProduct<A, B>::order(); }
+        uint64_t order(const value_type&) const ;
+    };
+
+    template <typename A, typename B>
+    SemidirectProduct<A, B>::SemidirectProduct(const Group<A>& normal, const Group<B>& complement)
+        : _normal{normal}, _complement{complement}
+    {
+        _n = static_cast<id_type>(normal.order());
+        _h = static_cast<id_type>(complement.order());
+        if (static_cast<uint64_t>(_n) * _h >= npos)
+            throw Exception(NOT_CONFORMANT, "Product is too large to be indexed...");
+        _normal_identity = normal.symbols().id(normal.identity());
+        _complement_identity = complement.symbols().id(complement.identity());
+    }
+
+    // The action is tabulated once and verified: every phi_h must be an
+    // automorphism of N, and h -> phi_h a homomorphism, O(|H||N|^2)
+    template <typename A, typename B>
+    SemidirectProduct<A, B>::SemidirectProduct(const Group<A>& normal, const Group<B>& complement, action_type&& action)
+        : SemidirectProduct{normal, complement}
+    {
+        _action.assign(static_cast<std::size_t>(_h) * _n, npos);
+        bool trivial = true ;
+        for (id_type h = 0; h < _h; ++h)
+        {
+            std::vector<bool> hit(_n, false);
+            for (id_type n = 0; n < _n; ++n)
+            {
+                auto image = normal.symbols().find(action(complement.symbols()[h], normal.symbols()[n]));
+                if (image == npos || hit[image])
+                    throw Exception(NOT_CONFORMANT, "Action is not a permutation of the normal factor...");
+                hit[image] = true ;
+                trivial = trivial && image == n ;
+                _action[static_cast<std::size_t>(h) * _n + n] = image ;
+            }
+            for (id_type x = 0; x < _n; ++x)
+                for (id_type y = 0; y < _n; ++y)
+                    if (_act(h, _nop(x, y)) != _nop(_act(h, x), _act(h, y)))
+                        throw Exception(NOT_CONFORMANT, "Action is not by automorphisms...");
+        }
+        for (id_type h = 0; h < _h; ++h)
+            for (id_type k = 0; k < _h; ++k)
+                for (id_type n = 0; n < _n; ++n)
+                    if (_act(_hop(h, k), n) != _act(h, _act(k, n)))
+                        throw Exception(NOT_CONFORMANT, "Action is not a homomorphism...");
+        if (trivial)
+            _action.clear();
+    }
+
+    template <typename A, typename B>
+    id_type
+    SemidirectProduct<A, B>::id(const value_type& x) const
+    {
+        auto n = _normal.symbols().find(x.first), h = _complement.symbols().find(x.second);
+        if (n == npos || h == npos)
+            throw Exception(NOT_A_MEMBER, "Parameters not in the product...");
+        return encode(n, h);
+    }
+
+    template <typename A, typename B>
+    typename SemidirectProduct<A, B>::value_type
+    SemidirectProduct<A, B>::value(id_type x) const
+    {
+        return value_type(_normal.symbols()[left(x)], _complement.symbols()[right(x)]);
+    }
+
+    template <typename A, typename B>
+    bool
+    SemidirectProduct<A, B>::contains(const value_type& x) const
+    {
+        return _normal.contains(x.first) && _complement.contains(x.second);
+    }
+
+    template <typename A, typename B>
+    id_type
+    SemidirectProduct<A, B>::multiply(id_type x, id_type y) const
+    {
+        auto h = right(x);
+        return encode(_nop(left(x), _act(h, left(y))), _hop(h, right(y)));
+    }
+
+    // (n, h)^-1 = (phi_h^-1(n^-1), h^-1)
+    template <typename A, typename B>
+    id_type
+    SemidirectProduct<A, B>::invert(id_type x) const
+    {
+        auto h = _complement.inverses()[right(x)];
+        return encode(_act(h, _normal.inverses()[left(x)]), h);
+    }
+
+    // The order of the element is itself found through power(), so the
+    // exponent is reduced mod |N| |H| instead, which every order divides
+    template <typename A, typename B>
+    id_type
+    SemidirectProduct<A, B>::power(id_type x, int64_t k) const
+    {
+        auto m = order();
+        uint64_t e = k < 0 ? m - 1u - static_cast<uint64_t>(-(k + 1)) % m : static_cast<uint64_t>(k) % m ;
+        id_type result = identity_id();
+        for (; e > 0u; e >>= 1)
+        {
+            if (e & 1u)
+                result = multiply(result, x);
+            x = multiply(x, x);
+        }
+        return result ;
+    }
+
+    // The order of h divides that of (n, h): (n, h)^|h| lies in N, whose
+    // order is then read off the factor's spectrum
+    template <typename A, typename B>
+    uint64_t
+    SemidirectProduct<A, B>::order(const value_type& x) const
+    {
+        auto m = _complement.order(x.second);
+        auto y = power(id(x), static_cast<int64_t>(m));
+        return m * _normal.orders()[left(y)];
+    }
+
+    // Only sensible for small products, the table has |N|^2 |H|^2 cells.
+    // The action was verified at construction, so the table is not checked
+    template <typename A, typename B>
+    Group<typename SemidirectProduct<A, B>::value_type>
+    SemidirectProduct<A, B>::materialize() const
+    {
+        auto symbols = std::make_shared<Interner<value_type>>();
+        auto size = static_cast<id_type>(order());
+        symbols->reserve(size);
+        for (id_type x = 0; x < size; ++x)
+            symbols->intern(value(x));
+        typename Group<value_type>::cells_type cells(static_cast<std::size_t>(size) * size);
+        for (id_type x = 0; x < size; ++x)
+            for (id_type y = 0; y < size; ++y)
+                cells[static_cast<std::size_t>(x) * size + y] = multiply(x, y);
+        std::vector<id_type> inverse(size);
+        for (id_type x = 0; x < size; ++x)
+            inverse[x] = invert(x);
+        return Group<value_type>{cells, symbols, identity_id(), inverse};
+    }
+
+    // lcm of the orders of the two components
+    template <typename A, typename B>
+    uint64_t
+    DirectProduct<A, B>::order(const value_type& x) const
+    {
+        uint64_t m = this->_normal.order(x.first), k = this->_complement.order(x.second);
+        uint64_t a = m, b = k ;
+        while (b)
+        {
+            auto t = a % b ;
+            a = b ;
+            b = t ;
+        }
+        return m / a * k ;
+    }
+
+    template <typename A, typename B> Group<Pair<A, B>> operator*(const Group<A>& lhs, const Group<B>& rhs)
+    {
+        return DirectProduct<A, B>{lhs, rhs}.materialize();
+    }
+}
+
+#endif
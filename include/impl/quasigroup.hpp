@@ -12,9 +12,9 @@ namespace zebra
         using typename Magma<T>::bin_op_type;
         using typename Magma<T>::titer ;
         using typename Magma<T>::param_type;
-        using typename Magma<T>::entry_type;
         using typename Magma<T>::table_type;
         using typename Magma<T>::iter ;
+        using typename Magma<T>::cells_type ;
         using Magma<T>::unital;
         using Magma<T>::at ;
         using Magma<T>::commutative;
@@ -23,6 +23,7 @@ namespace zebra
         QuasiGroup(const table_type&, const Set<T>&);
         QuasiGroup(iter, iter, const Set<T>&);
         QuasiGroup(bin_op_type&&, const Set<T>&);
+        QuasiGroup(const cells_type&, const SharedInterner<T>&);
         
         bool loop() const { return unital(); }
         bool right_bol_loop() const ;
@@ -36,7 +37,8 @@ namespace zebra
     protected:
         void check() throw(Exception);  
         
-        using Magma<T>::_set ;
+        using Magma<T>::_order ;
+        using Magma<T>::_op ;
     };
     
     // In order to check divisibility, it is enough to check if the
@@ -45,20 +47,15 @@ namespace zebra
     void
     QuasiGroup<T>::check() throw(Exception)
     {
-        for (auto&& x : _set)
+        for (id_type x = 0; x < _order; ++x)
         {
-            HashMap<T, unsigned> counts1, counts2;
-            for (auto&& y : _set)
+            std::vector<bool> row(_order, false), column(_order, false);
+            for (id_type y = 0; y < _order; ++y)
             {
-                counts1[at(x, y)]++;
-                counts2[at(y, x)]++;
-            }
-            for (auto it = counts1.cbegin(); it != counts1.cend(); ++it)
-                if (it->second > 1u)
-                    throw Exception(NOT_CONFORMANT, "Does not satisfy divisibility property...");
-            for (auto it = counts2.cbegin(); it != counts2.cend(); ++it)
-                if (it->second > 1u)
+                if (row[_op(x, y)] || column[_op(y, x)])
                     throw Exception(NOT_CONFORMANT, "Does not satisfy divisibility property...");
+                row[_op(x, y)] = column[_op(y, x)] = true ;
+            }
         }
     }
     
@@ -78,7 +75,14 @@ namespace zebra
     
     template <typename T>
     QuasiGroup<T>::QuasiGroup(bin_op_type&& func, const Set<T>& set)
-        : Magma<T>{func, set}
+        : Magma<T>{std::move(func), set}
+    {
+        check();
+    }
+
+    template <typename T>
+    QuasiGroup<T>::QuasiGroup(const cells_type& cells, const SharedInterner<T>& symbols)
+        : Magma<T>{cells, symbols}
     {
         check();
     }
@@ -87,8 +91,8 @@ namespace zebra
     bool
     QuasiGroup<T>::left_bol_loop() const
     {
-        return all3(_set, [this](auto x, auto y, auto z) -> bool {
-            return at(x, at(y, at(x, z))) == at(at(x, at(y, x)), z);
+        return all3_ids(_order, [this](id_type x, id_type y, id_type z) -> bool {
+            return this->_op(x, this->_op(y, this->_op(x, z))) == this->_op(this->_op(x, this->_op(y, x)), z);
         });
     }
     
@@ -96,8 +100,8 @@ namespace zebra
     bool
     QuasiGroup<T>::right_bol_loop() const
     {
-        return all3(_set, [this](auto x, auto y, auto z) -> bool {
-            return at(at(at(z, x), y), x) == at(z, at(at(x, y), x));
+        return all3_ids(_order, [this](id_type x, id_type y, id_type z) -> bool {
+            return this->_op(this->_op(this->_op(z, x), y), x) == this->_op(z, this->_op(this->_op(x, y), x));
         });
     }
     
@@ -105,8 +109,8 @@ namespace zebra
     bool
     QuasiGroup<T>::semi_symmetric() const
     {
-        return all2(_set, [this](auto x, auto y) -> bool {
-            return x == at(at(y, x), y) && x == at(y, at(x, y));
+        return all2_ids(_order, [this](id_type x, id_type y) -> bool {
+            return x == this->_op(this->_op(y, x), y) && x == this->_op(y, this->_op(x, y));
         });
     }
     
@@ -114,11 +118,11 @@ namespace zebra
     bool
     QuasiGroup<T>::total_antisymmetric() const 
     {
-        return all3(_set, [this](auto c, auto x, auto y) -> bool {
-            return (at(c, at(x, y)) == at(at(c, y), x) ? x == y : true) &&
-                   (at(x, y) == at(y, x) ? x == y : true);
+        return all3_ids(_order, [this](id_type c, id_type x, id_type y) -> bool {
+            return (this->_op(c, this->_op(x, y)) == this->_op(this->_op(c, y), x) ? x == y : true) &&
+                   (this->_op(x, y) == this->_op(y, x) ? x == y : true);
         });
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,121 @@
+#ifndef ZEBRA_QUOTIENT
+#define ZEBRA_QUOTIENT
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // The quotient G/N of a finite group by a normal subgroup, itself a
+    // Group over the coset ids [0, |G/N|). Cosets are numbered in order of
+    // their smallest element id, whose element is the representative, and
+    // every element of G knows its coset through a dense array. The table
+    // is built from the representatives alone, gN hN = (gh)N, in O(|G/N|^2),
+    // and is not checked again: it is a group because N is normal.
+    template <typename T>
+    class QuotientGroup : public Group<id_type>
+    {
+    public:
+
+        QuotientGroup() {}
+        QuotientGroup(const Group<T>&, const Bitset&);
+
+        const Group<T>&             parent() const { return _parent; }
+        Subgroup<T>                 kernel() const { return Subgroup<T>{_parent, _kernel}; }
+        std::size_t                 index() const { return _transversal.size(); }
+        id_type                     coset(const T& g) const { return _cosets[_parent.symbols().id(g)]; }
+        T                           representative(id_type c) const { return _parent.symbols()[_transversal[c]]; }
+        Set<T>                      members(id_type) const ;
+        const std::vector<id_type>& cosets() const { return _cosets; }
+        const std::vector<id_type>& transversal() const { return _transversal; }
+        Mapping<T, id_type>         projection() const ;
+
+    protected:
+
+        Group<T>             _parent ;
+        Bitset               _kernel ;
+        std::vector<id_type> _cosets ;
+        std::vector<id_type> _transversal ;
+    };
+
+    // The coset index rejects a kernel that is not closed, and N is normal
+    // exactly when its left and right cosets coincide
+    template <typename T>
+    QuotientGroup<T>::QuotientGroup(const Group<T>& parent, const Bitset& kernel)
+        : _parent{parent}, _kernel{kernel}
+    {
+        auto order = static_cast<id_type>(parent.order());
+        CosetIndex<T> cosets{parent, kernel};
+        if (!cosets.normal())
+            throw Exception(NOT_CONFORMANT, "The group as argument is not a normal subgroup...");
+        const auto& cells = parent.cells();
+        _cosets = cosets.left();
+        _transversal = cosets.left_transversal();
+
+        auto index = static_cast<id_type>(_transversal.size());
+        auto symbols = std::make_shared<Interner<id_type>>();
+        symbols->reserve(index);
+        for (id_type c = 0; c < index; ++c)
+            symbols->intern(c);
+        cells_type table(static_cast<std::size_t>(index) * index);
+        for (id_type a = 0; a < index; ++a)
+            for (id_type b = 0; b < index; ++b)
+                table[static_cast<std::size_t>(a) * index + b] =
+                    _cosets[cells[static_cast<std::size_t>(_transversal[a]) * order + _transversal[b]]];
+        std::vector<id_type> inverse(index);
+        for (id_type c = 0; c < index; ++c)
+            inverse[c] = _cosets[parent.inverses()[_transversal[c]]];
+        static_cast<Group<id_type>&>(*this) = Group<id_type>{table, symbols, _cosets[parent.symbols().id(parent.identity())], inverse};
+    }
+
+    template <typename T>
+    Set<T>
+    QuotientGroup<T>::members(id_type c) const
+    {
+        Set<T> result ;
+        for (id_type g = 0; g < _cosets.size(); ++g)
+            if (_cosets[g] == c)
+                result.insert(_parent.symbols()[g]);
+        return result ;
+    }
+
+    // The canonical projection g -> gN, sharing the carriers of both groups
+    template <typename T>
+    Mapping<T, id_type>
+    QuotientGroup<T>::projection() const
+    {
+        return Mapping<T, id_type>{_parent.shared_symbols(), _symbols, _cosets};
+    }
+
+    template <typename T>
+    QuotientGroup<T>
+    Group<T>::quotient(const Group<T>& group) const
+    {
+        if (!subgroup(group))
+            throw Exception(NOT_CONFORMANT, "The group as argument is not a normal subgroup...");
+        Bitset members(_order);
+        for (auto&& x : _embed(group))
+            members.set(x);
+        return QuotientGroup<T>{*this, members};
+    }
+
+    template <typename T>
+    QuotientGroup<T>
+    Group<T>::quotient(const Sub<T, Group>& view) const
+    {
+        if (&view.parent().cells() != &this->cells())
+            return quotient(view.materialize());
+        return QuotientGroup<T>{*this, view.members()};
+    }
+
+    template <typename A> QuotientGroup<A> operator/(const Group<A>& lhs, const Group<A>& rhs)
+    {
+        return lhs.quotient(rhs);
+    }
+
+    template <typename A> QuotientGroup<A> operator/(const Group<A>& lhs, const Sub<A, Group>& rhs)
+    {
+        return lhs.quotient(rhs);
+    }
+}
+
+#endif
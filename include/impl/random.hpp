@@ -0,0 +1,182 @@
+#ifndef ZEBRA_RANDOM
+#define ZEBRA_RANDOM
+
+#include "permutation.hpp"
+#include <random>
+
+namespace zebra
+{
+    // Random elements of a group known only by generators and its
+    // operation, by product replacement with an accumulator ("rattle"):
+    // r >= 10 slots start as copies of the generators, every step replaces
+    // a random slot x_i by x_i x_j^(+-1) or x_j^(+-1) x_i for another slot j,
+    // and the accumulator is multiplied by the new x_i and returned. After
+    // the burn in, the output is close to uniform in practice. The engine
+    // is seeded, so a seed always gives the same sequence. Nothing is
+    // enumerated: the estimators below only sample.
+    template <typename T>
+    class ProductReplacement
+    {
+    public:
+        typedef typename std::conditional<
+            std::is_arithmetic<T>::value,
+            std::function<T(T, T)>,
+            std::function<T(const T&, const T&)>>::type op_type;
+        typedef typename std::conditional<
+            std::is_arithmetic<T>::value,
+            std::function<T(T)>,
+            std::function<T(const T&)>>::type inverse_type;
+        typedef typename std::conditional<
+            std::is_arithmetic<T>::value,
+            std::function<uint64_t(T)>,
+            std::function<uint64_t(const T&)>>::type order_type;
+        typedef typename std::conditional<
+            std::is_arithmetic<T>::value,
+            std::function<bool(T, T)>,
+            std::function<bool(const T&, const T&)>>::type generates_type;
+
+        ProductReplacement() {}
+        ProductReplacement(const std::vector<T>&, const T&, op_type&&, inverse_type&&, uint64_t = 0u,
+                           order_type&& = nullptr, generates_type&& = nullptr);
+
+        const T&       identity() const { return _identity; }
+        T              next();
+        std::vector<T> batch(std::size_t);
+
+        double                   commuting_probability(std::size_t);
+        HashMap<uint64_t, double> order_distribution(std::size_t);
+        double                   generation_probability(std::size_t);
+
+    protected:
+
+        uint64_t _order(const T&) const ;
+
+        std::vector<T>     _slots ;
+        T                  _accumulator ;
+        T                  _identity ;
+        op_type            _op ;
+        inverse_type       _inverse ;
+        order_type         _orders ;
+        generates_type     _generates ;
+        std::mt19937_64    _engine ;
+    };
+
+    template <typename T>
+    ProductReplacement<T>::ProductReplacement(const std::vector<T>& generators, const T& identity, op_type&& op,
+                                              inverse_type&& inverse, uint64_t seed, order_type&& orders,
+                                              generates_type&& generates)
+        : _accumulator{identity}, _identity{identity}, _op{std::move(op)}, _inverse{std::move(inverse)},
+          _orders{std::move(orders)}, _generates{std::move(generates)}, _engine{seed}
+    {
+        auto slots = std::max<std::size_t>(10u, generators.size());
+        for (std::size_t i = 0; i < slots; ++i)
+            _slots.push_back(generators.empty() ? identity : generators[i % generators.size()]);
+        for (std::size_t i = 0; i < std::max<std::size_t>(50u, 10u * slots); ++i)
+            next();
+    }
+
+    template <typename T>
+    T
+    ProductReplacement<T>::next()
+    {
+        std::uniform_int_distribution<std::size_t> pick(0u, _slots.size() - 1u), other(0u, _slots.size() - 2u);
+        std::uniform_int_distribution<int> coin(0, 3);
+        auto i = pick(_engine), j = other(_engine);
+        if (j >= i)
+            ++j ;
+        auto side = coin(_engine);
+        auto y = side & 1 ? _inverse(_slots[j]) : _slots[j];
+        _slots[i] = side & 2 ? _op(_slots[i], y) : _op(y, _slots[i]);
+        _accumulator = _op(_accumulator, _slots[i]);
+        return _accumulator ;
+    }
+
+    template <typename T>
+    std::vector<T>
+    ProductReplacement<T>::batch(std::size_t count)
+    {
+        std::vector<T> result ;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(next());
+        return result ;
+    }
+
+    // Without an order function, powers are taken until the identity
+    template <typename T>
+    uint64_t
+    ProductReplacement<T>::_order(const T& x) const
+    {
+        if (_orders)
+            return _orders(x);
+        uint64_t result = 1u ;
+        for (T y = x; !(y == _identity); y = _op(y, x))
+            ++result ;
+        return result ;
+    }
+
+    // Estimates |{(x, y) : xy = yx}| / |G|^2, which is k(G) / |G|
+    template <typename T>
+    double
+    ProductReplacement<T>::commuting_probability(std::size_t samples)
+    {
+        std::size_t hits = 0u ;
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            auto x = next(), y = next();
+            hits += _op(x, y) == _op(y, x);
+        }
+        return samples ? static_cast<double>(hits) / samples : 0.0 ;
+    }
+
+    template <typename T>
+    HashMap<uint64_t, double>
+    ProductReplacement<T>::order_distribution(std::size_t samples)
+    {
+        HashMap<uint64_t, double> result ;
+        for (std::size_t i = 0; i < samples; ++i)
+            result[_order(next())] += 1.0 / samples ;
+        return result ;
+    }
+
+    template <typename T>
+    double
+    ProductReplacement<T>::generation_probability(std::size_t samples)
+    {
+        if (!_generates)
+            throw Exception(DOES_NOT_EXIST, "No generation test for this group...");
+        std::size_t hits = 0u ;
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            auto x = next(), y = next();
+            hits += _generates(x, y);
+        }
+        return samples ? static_cast<double>(hits) / samples : 0.0 ;
+    }
+
+    template <typename T>
+    ProductReplacement<T> product_replacement(const Group<T>& group, uint64_t seed = 0u)
+    {
+        return ProductReplacement<T>{group.generators(), group.identity(),
+            [group](const T& x, const T& y) { return group.at(x, y); },
+            [group](const T& x) { return group.inverse(x); }, seed,
+            [group](const T& x) { return group.order(x); },
+            [group](const T& x, const T& y) { return group.generate({x, y}).size() == group.order(); }};
+    }
+
+    // Orders through the cycle type, generation through Schreier-Sims
+    inline ProductReplacement<Permutation> product_replacement(const PermutationGroup& group, uint64_t seed = 0u)
+    {
+        auto order = group.order();
+        auto degree = group.degree();
+        return ProductReplacement<Permutation>{group.generators(), group.identity(),
+            [](const Permutation& x, const Permutation& y) { return x * y; },
+            [](const Permutation& x) { return x.inverse(); }, seed,
+            [](const Permutation& x) { return x.order(); },
+            [order, degree](const Permutation& x, const Permutation& y) {
+                return PermutationGroup{degree, {x, y}}.order() == order;
+            }};
+    }
+}
+
+#endif
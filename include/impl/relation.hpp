@@ -2,6 +2,8 @@
 #define ZEBRA_RELATION
 
 #include "keys.hpp"
+#include "row.hpp"
+#include "cow.hpp"
 
 namespace zebra
 {
@@ -45,8 +47,43 @@ namespace zebra
         STRICT_ORDER         = IRREFLEXIVE | ANTISYMMETRIC | TRANSITIVE
     };
     
+    
     template <typename, typename> class Mapping ;
     
+    namespace
+    {
+        // Homogenous relations over the same carrier share one interner, so
+        // that an element has the same id on both sides of the relation.
+        template <typename D, typename R>
+        SharedInterner<R> share_symbols(const SharedInterner<D>&, const Set<D>&, const Set<R>& codomain)
+        {
+            return make_interner(codomain);
+        }
+        
+        template <typename T>
+        SharedInterner<T> share_symbols(const SharedInterner<T>& symbols, const Set<T>& from, const Set<T>& codomain)
+        {
+            return from == codomain ? symbols : make_interner(codomain);
+        }
+        
+        template <typename D, typename R>
+        SharedInterner<R> share_symbols(const SharedInterner<D>&, const SharedInterner<R>& codomain)
+        {
+            return codomain ;
+        }
+        
+        template <typename T>
+        SharedInterner<T> share_symbols(const SharedInterner<T>& symbols, const SharedInterner<T>& codomain)
+        {
+            return same_symbols(*symbols, *codomain) ? symbols : codomain ;
+        }
+    }
+    
+    // Pairs are stored as rows of codomain ids, indexed by domain id. The
+    // carriers are interned once at construction and never re-hashed inside.
+    // Rows are small-buffer Rows, so sparse relations and functions cost a
+    // couple of words per domain element. The interners are the carriers and
+    // the rows are copy-on-write, so copying a relation is O(1).
     template <typename D, typename R>
     class BinaryRelation
     {
@@ -57,12 +94,13 @@ namespace zebra
         typedef typename pset_type::const_iterator piter ;
         typedef typename Set<D>::const_iterator    diter ;
         typedef typename Set<R>::const_iterator    riter ;
-        typedef HashMap<diter, Set<riter>>         rel_type;
+        typedef Row                                row_type;
+        typedef std::vector<row_type>              rel_type;
         typedef typename rel_type::const_iterator  iter ;
         typedef std::function<bool(D, R)>          membership_type;
         typedef std::function<R(D)>                evaluation_type;
        
-        BinaryRelation() {}
+        BinaryRelation() { _intern(Set<D>{}, Set<R>{}); }
         BinaryRelation(piter, piter, diter, diter, riter, riter) ; 
         BinaryRelation(const pset_type&, const Set<D>&, const Set<R>&);
         BinaryRelation(const pset_type&);
@@ -74,11 +112,13 @@ namespace zebra
         BinaryRelation(evaluation_type&&, const Set<D>&, const Set<R>&);
         BinaryRelation(evaluation_type&&, diter, diter);
         BinaryRelation(evaluation_type&&, const Set<D>&);
-        BinaryRelation(const BinaryRelation<D, R>&);
         
-        std::size_t size() const { return _relation.size(); }
-        iter        cbegin() const { return _relation.cbegin(); }
-        iter        cend() const { return _relation.cend(); }
+        std::size_t size() const ;
+        iter        cbegin() const { return _relation->cbegin(); }
+        iter        cend() const { return _relation->cend(); }
+        
+        const Interner<D>& domain_symbols() const { return *_dsym; }
+        const Interner<R>& codomain_symbols() const { return *_rsym; }
         
         bool   exists(const D&, const R&) const ;
         bool   exists(const Pair<D, R>&) const ;
@@ -119,7 +159,7 @@ namespace zebra
         HOM(bool) euclidean() const ;       // TODO
         HOM(bool) serial() const ;
         HOM(bool) transitive() const ;
-        HOM(bool) transitive_noncomp() const { complement().transitive(); }
+        HOM(bool) transitive_noncomp() const { return complement().transitive(); }
         HOM(bool) equivalence() const { return reflexive() && symmetric() && transitive(); }
         HOM(bool) partial_equivalence() const { return symmetric() && transitive(); }
         HOM(bool) preorder() const { return reflexive() && transitive(); }
@@ -137,7 +177,7 @@ namespace zebra
         
         HOM(Set<R>)                 equivalence_class(const D&) const;
         HOM(qset_type)              quotient_set() const ;
-        HOM2(Mapping<D, qset_type>) projection() const ;
+        HOM2(Mapping<D, Set<R>>)    projection() const ;
         HOM2(BinaryRelation<D, R>)  reflexive_closure() const ;
         HOM2(BinaryRelation<D, R>)  reflexive_reduction() const ;
         HOM2(BinaryRelation<D, R>)  transitive_closure() const ;
@@ -151,20 +191,24 @@ namespace zebra
         template <typename A, typename B> friend BinaryRelation<A, B> combination(const BinaryRelation<A, B>&, const BinaryRelation<A, B>&);
         template <typename A, typename B> friend BinaryRelation<A, B> intersection(const BinaryRelation<A, B>&, const BinaryRelation<A, B>&);
         template <typename A, typename B, typename C> friend BinaryRelation<A, C> composition(const BinaryRelation<A, B>&, const BinaryRelation<B, C>&);
+        template <typename, typename> friend class BinaryRelation ;
         
     protected:
     
-        rel_type _relation;
-        Set<D>   _from ;
-        Set<R>   _codomain ;
+        Cow<rel_type>      _relation;
+        SharedInterner<D>  _dsym ;
+        SharedInterner<R>  _rsym ;
         
         HOM(Set<D>) all() const ;
         void      add(const D&, const R&);
         void      add(const Pair<D, R>&);
-        void      add(const D&, riter, riter);       
-        diter     _ditr(const D&) const ;
-        riter     _ritr(const R&) const ;
-        bool      _exists(diter, riter) const ;
+        void      add(const D&, riter, riter);
+        void      _intern(const Set<D>&, const Set<R>&);
+        void      _share(const BinaryRelation<D, R>&);
+        bool      _exists(id_type d, id_type r) const { return (*_relation)[d].count(r) > 0; }
+        id_type   _dsize() const { return static_cast<id_type>(_dsym->size()); }
+        id_type   _rsize() const { return static_cast<id_type>(_rsym->size()); }
+        bool      _homogenous() const { return static_cast<const void*>(_dsym.get()) == static_cast<const void*>(_rsym.get()); }
         
     };
 
@@ -172,49 +216,52 @@ namespace zebra
     
     template <typename D, typename R>
     void
-    BinaryRelation<D, R>::add(const D& first, const R& second)
+    BinaryRelation<D, R>::_intern(const Set<D>& from, const Set<R>& codomain)
     {
-        auto ritr = _ritr(second);
-        auto ditr = _ditr(first);
-        if (ritr != _codomain.cend() && ditr != _from.cend())
-            _relation[ditr].insert(ritr);
+        _dsym = make_interner(from);
+        _rsym = share_symbols(_dsym, from, codomain);
+        _relation = rel_type(_dsym->size());
     }
     
+    // Empty relation over the carriers (and ids) of another one
     template <typename D, typename R>
     void
-    BinaryRelation<D, R>::add(const D& first, riter start, riter end)
+    BinaryRelation<D, R>::_share(const BinaryRelation<D, R>& other)
     {
-        auto ditr = _ditr(first);
-        if (ditr != _from.cend())
-            _relation[ditr].insert(start, end);
+        _dsym = other._dsym ;
+        _rsym = other._rsym ;
+        _relation = rel_type(_dsym->size());
     }
     
     template <typename D, typename R>
     void
-    BinaryRelation<D, R>::add(const Pair<D, R>& pair)
-    {
-        add(pair.first, pair.second);
-    }
-    
-    template <typename D, typename R>
-    typename BinaryRelation<D, R>::riter
-    BinaryRelation<D, R>::_ritr(const R& val) const
+    BinaryRelation<D, R>::add(const D& first, const R& second)
     {
-        return _codomain.find(val);
+        auto rid = _rsym->find(second);
+        auto did = _dsym->find(first);
+        if (rid != npos && did != npos)
+            _relation.write()[did].insert(rid);
     }
     
     template <typename D, typename R>
-    typename BinaryRelation<D, R>::diter
-    BinaryRelation<D, R>::_ditr(const D& val) const
+    void
+    BinaryRelation<D, R>::add(const D& first, riter start, riter end)
     {
-        return _from.find(val);
+        auto did = _dsym->find(first);
+        if (did != npos)
+            for (; start != end; ++start)
+            {
+                auto rid = _rsym->find(*start);
+                if (rid != npos)
+                    _relation.write()[did].insert(rid);
+            }
     }
     
     template <typename D, typename R>
-    bool
-    BinaryRelation<D, R>::_exists(diter dit, riter rit) const
+    void
+    BinaryRelation<D, R>::add(const Pair<D, R>& pair)
     {
-        return _relation.count(dit) > 0 && _relation.at(dit).count(rit) > 0 ;
+        add(pair.first, pair.second);
     }
     
     template <typename D, typename R>
@@ -222,16 +269,15 @@ namespace zebra
                                          diter dstart, diter dend, 
                                          riter rstart, riter rend) 
     {
-        _from = Set<D>{dstart, dend};
-        _codomain = Set<R>{rstart, rend};
+        _intern(Set<D>(dstart, dend), Set<R>(rstart, rend));
         for(; pstart != pend; ++pstart)
             add(*pstart);
     }
     
     template <typename D, typename R>
     BinaryRelation<D, R>::BinaryRelation(const pset_type& pairs, const Set<D>& from, const Set<R>& codomain)
-        : _from{from}, _codomain{codomain}
     {
+        _intern(from, codomain);
         for (auto it = pairs.cbegin(); it != pairs.cend(); ++it)
             add(*it);
     }
@@ -239,11 +285,14 @@ namespace zebra
     template <typename D, typename R>
     BinaryRelation<D, R>::BinaryRelation(const pset_type& pairs)
     {
+        Set<D> from ;
+        Set<R> codomain ;
         for (auto&& pair : pairs)
         {
-            _from.insert(pair.first);
-            _codomain.insert(pair.second);
+            from.insert(pair.first);
+            codomain.insert(pair.second);
         }
+        _intern(from, codomain);
         for (auto&& pair : pairs)
             add(pair);
     }
@@ -254,48 +303,31 @@ namespace zebra
                                          diter dend, 
                                          riter rstart, 
                                          riter rend)
-    {
-        _from = Set<D>{dstart, dend};
-        _codomain = Set<R>{rstart, rend};
-        auto pairs = make_pairs(_from, _codomain);
-        for (const auto& pair : pairs)
-            if (relation(pair.first) == pair.second)
-                add(pair);
-    }
+        : BinaryRelation<D, R>{std::move(relation), Set<D>(dstart, dend), Set<R>(rstart, rend)}
+    {}
     
     template <typename D, typename R>
     BinaryRelation<D, R>::BinaryRelation(membership_type&& relation,
                                          diter dstart, 
                                          diter dend)
-    {
-        static_assert(std::is_same<D, R>::value, "Relation must be on S -> S");
-        _from = Set<D>{dstart, dend};
-        _codomain = Set<R>{dstart, dend};
-        auto pairs = make_pairs(_from, _from);
-        for (const auto& pair : pairs)
-            if (relation(pair.first, pair.second))
-                add(pair);
-    }
+        : BinaryRelation<D, R>{std::move(relation), Set<D>(dstart, dend)}
+    {}
     
     template <typename D, typename R>
     BinaryRelation<D, R>::BinaryRelation(membership_type&& relation, const Set<D>& from, const Set<R>& codomain)
-        : _from{from}, _codomain{codomain}
     {
-        auto pairs = make_pairs(_from, _codomain);
-        for (const auto& pair : pairs)
-            if (relation(pair.first, pair.second))
-                add(pair);
+        _intern(from, codomain);
+        for (id_type x = 0; x < _dsize(); ++x)
+            for (id_type y = 0; y < _rsize(); ++y)
+                if (relation((*_dsym)[x], (*_rsym)[y]))
+                    _relation.write()[x].insert(y);
     }
     
     template <typename D, typename R>
     BinaryRelation<D, R>::BinaryRelation(membership_type&& relation, const Set<D>& set)
-        : _from{set}, _codomain{set}
+        : BinaryRelation<D, R>{std::move(relation), set, set}
     {
         static_assert(std::is_same<D, R>::value, "Relation must be on S -> S");
-        auto pairs = make_pairs(_from, _from);
-        for (const auto& pair : pairs)
-            if (relation(pair.first, pair.second))
-                add(pair);
     }
     
     template <typename D, typename R>
@@ -304,31 +336,58 @@ namespace zebra
                                          diter dend, 
                                          riter rstart, 
                                          riter rend)
+        : BinaryRelation<D, R>{std::move(relation), Set<D>(dstart, dend), Set<R>(rstart, rend)}
+    {}
+    
+    template <typename D, typename R>
+    BinaryRelation<D, R>::BinaryRelation(evaluation_type&& relation,
+                                         diter dstart, 
+                                         diter dend)
+        : BinaryRelation<D, R>{std::move(relation), Set<D>(dstart, dend)}
+    {}
+    
+    template <typename D, typename R>
+    BinaryRelation<D, R>::BinaryRelation(evaluation_type&& relation, const Set<D>& from, const Set<R>& codomain)
     {
-        _from = Set<D>{dstart, dend};
-        _codomain = Set<R>{rstart, rend};
-        for (auto&& x : _from)
-            if (_codomain.find(relation(x)) != _codomain.cend())
-                add(x, relation(x));
+        _intern(from, codomain);
+        for (id_type x = 0; x < _dsize(); ++x)
+        {
+            auto y = _rsym->find(relation((*_dsym)[x]));
+            if (y != npos)
+                _relation.write()[x].insert(y);
+        }
     }
     
     template <typename D, typename R>
-    BinaryRelation<D, R>::BinaryRelation(const BinaryRelation<D, R>& copy)
+    BinaryRelation<D, R>::BinaryRelation(evaluation_type&& relation, const Set<D>& set)
+        : BinaryRelation<D, R>{std::move(relation), set, set}
     {
-        _codomain = copy._codomain;
-        _from = copy._from;
-        for (auto&& pair : copy._relation)
-            add(pair);
+        static_assert(std::is_same<D, R>::value, "Relation must be on S -> S");
+    }
+    
+    template <typename D, typename R>
+    std::size_t
+    BinaryRelation<D, R>::size() const
+    {
+        std::size_t count = 0u ;
+        for (auto&& row : *_relation)
+            if (!row.empty())
+                ++count ;
+        return count ;
     }
     
     template <typename D, typename R>
     Set<R>
     BinaryRelation<D, R>::range() const
     {
+        std::vector<bool> seen(_rsize(), false);
+        for (auto&& row : *_relation)
+            for (auto&& element : row)
+                seen[element] = true ;
         Set<R> result ;
-        for (auto&& pair : _relation)
-            for (auto&& element : pair.second)
-                result.insert(*element);
+        for (id_type y = 0; y < _rsize(); ++y)
+            if (seen[y])
+                result.insert((*_rsym)[y]);
         return std::move(result);
     }
     
@@ -337,8 +396,9 @@ namespace zebra
     BinaryRelation<D, R>::domain() const
     {
         Set<D> result ;
-        for (auto it = cbegin(); it != cend(); ++it)
-            result.insert(*it->first);
+        for (id_type x = 0; x < _relation->size(); ++x)
+            if (!(*_relation)[x].empty())
+                result.insert((*_dsym)[x]);
         return std::move(result);
     }
     
@@ -347,10 +407,11 @@ namespace zebra
     BinaryRelation<D, R>::foreset(const R& val) const
     {
         Set<D> result ;
-        auto pos = _codomain.find(val);
-        for (auto it = cbegin(); it != cend(); ++it)
-            if (it->second.find(pos) != it->second.cend())
-                result.insert(*it->first);
+        auto pos = _rsym ? _rsym->find(val) : npos;
+        if (pos != npos)
+            for (id_type x = 0; x < _relation->size(); ++x)
+                if (_exists(x, pos))
+                    result.insert((*_dsym)[x]);
         return std::move(result);
     }
     
@@ -359,8 +420,10 @@ namespace zebra
     BinaryRelation<D, R>::afterset(const D& val) const
     {
         Set<R> result ;
-        for (auto&& it : _relation.at(_ditr(val)))
-            result.insert(*it);
+        auto pos = _dsym ? _dsym->find(val) : npos;
+        if (pos != npos)
+            for (auto&& it : (*_relation)[pos])
+                result.insert((*_rsym)[it]);
         return std::move(result);
     }
     
@@ -369,9 +432,9 @@ namespace zebra
     BinaryRelation<D, R>::allpairs() const
     {
         Set<Pair<D, R>> result ;
-        for (auto&& pair : _relation)
-            for (auto&& element : pair.second)
-                result.insert(Pair<D, R>(*pair.first, *element));
+        for (id_type x = 0; x < _relation->size(); ++x)
+            for (auto&& element : (*_relation)[x])
+                result.insert(Pair<D, R>((*_dsym)[x], (*_rsym)[element]));
         return std::move(result);
     }
     
@@ -379,7 +442,10 @@ namespace zebra
     bool
     BinaryRelation<D, R>::exists(const D& dval, const R& rval) const
     {
-        return _exists(_ditr(dval), _ritr(rval));
+        if (!_dsym)
+            return false;
+        auto did = _dsym->find(dval), rid = _rsym->find(rval);
+        return did != npos && rid != npos && _exists(did, rid);
     }
     
     template <typename D, typename R>
@@ -393,7 +459,8 @@ namespace zebra
     bool
     BinaryRelation<D, R>::exists(const D& dval) const
     {
-        return _relation.count(_ditr(dval)) > 0;
+        auto did = _dsym ? _dsym->find(dval) : npos;
+        return did != npos && !(*_relation)[did].empty();
     }
     
     template <typename D, typename R>
@@ -401,15 +468,11 @@ namespace zebra
     BinaryRelation<D, R>::complement() const
     {
         BinaryRelation<D, R> comp ;
-        comp._codomain = _codomain ;
-        comp._from = _from ;
-        for (auto&& keyval : _from)
-            if (_relation.count(_ditr(keyval)) > 0)
-                for (auto it = _codomain.cbegin(); it != _codomain.cend(); ++it)
-                    if (!exists(keyval, *it))
-                        comp.add(keyval, *it);
-            else
-                comp.add(keyval, comp._codomain.cbegin(), comp._codomain.cend());
+        comp._share(*this);
+        for (id_type x = 0; x < _dsize(); ++x)
+            for (id_type y = 0; y < _rsize(); ++y)
+                if (!_exists(x, y))
+                    comp._relation.write()[x].insert(y);
         return std::move(comp);
     }
     
@@ -418,25 +481,27 @@ namespace zebra
     BinaryRelation<D, R>::inverse() const
     {
         BinaryRelation<R, D> comp ;
-        comp._codomain = _from ;
-        comp._from = _codomain ;
-        for (auto&& pair : _relation)
-            for (auto&& element : pair.second)
-                comp.add(*element, *pair);
+        comp._dsym = _rsym ;
+        comp._rsym = _dsym ;
+        comp._relation = typename BinaryRelation<R, D>::rel_type(_rsize());
+        for (id_type x = 0; x < _relation->size(); ++x)
+            for (auto&& element : (*_relation)[x])
+                comp._relation.write()[element].insert(x);
         return std::move(comp);
     }
     
     template <typename D, typename R>
-    HOM(Set<D>) 
+    HOM_DEF(Set<D>) 
     BinaryRelation<D, R>::all() const 
     {
         Set<D> result ;
-        for (const auto& pair : _relation)
-        {
-            result.insert(*pair.first);
-            for (const auto& it : pair.second)
-                result.insert(*it);
-        }
+        for (id_type x = 0; x < _relation->size(); ++x)
+            if (!(*_relation)[x].empty())
+            {
+                result.insert((*_dsym)[x]);
+                for (const auto& it : (*_relation)[x])
+                    result.insert((*_rsym)[it]);
+            }
         return result;
     }
     
@@ -444,250 +509,305 @@ namespace zebra
     bool
     BinaryRelation<D, R>::contains(const BinaryRelation<D, R>& subset) const
     {
-        if (subset.size() <= size())
-        {
-            if (_codomain != subset._codomain || _from != subset._from)
-                return false ;
-            for (auto&& pair : subset._relation)
-                for (auto&& element : pair.second)
-                    if (!exists(*pair.first, *element))
-                        return false;
-            return true;
-        }
-        return false;
+        if (!same_symbols(*_rsym, *subset._rsym) || !same_symbols(*_dsym, *subset._dsym))
+            return false ;
+        auto dmap = translation(*subset._dsym, *_dsym);
+        auto rmap = translation(*subset._rsym, *_rsym);
+        for (id_type x = 0; x < subset._relation->size(); ++x)
+            for (auto&& element : (*subset._relation)[x])
+                if (!_exists(dmap[x], rmap[element]))
+                    return false;
+        return true;
     }
     
     template <typename D, typename R>
     bool
     BinaryRelation<D, R>::injective() const
     {
-        return zebra::all(_from, _from, _codomain, [this](auto x, auto y, auto z) -> bool {
-            return (this->exists(x, z) && this->exists(y, z)) ? x == y : true;
-        });
+        std::vector<bool> hit(_rsize(), false);
+        for (auto&& row : *_relation)
+            for (auto&& element : row)
+            {
+                if (hit[element])
+                    return false;
+                hit[element] = true ;
+            }
+        return true;
     }
     
     template <typename D, typename R>
     bool
     BinaryRelation<D, R>::functional() const
     {
-        return zebra::all(_codomain, _codomain, _from, [this](auto x, auto y, auto z) -> bool {
-            return (this->exists(x, y) && this->exists(x, z)) ? z == y : true;
-        });
+        for (auto&& row : *_relation)
+            if (row.size() > 1u)
+                return false;
+        return true;
     }
     
     template <typename D, typename R>
     bool
     BinaryRelation<D, R>::surjective() const
     {
-        return _codomain == range() ;
+        std::vector<bool> hit(_rsize(), false);
+        for (auto&& row : *_relation)
+            for (auto&& element : row)
+                hit[element] = true ;
+        return std::find(hit.cbegin(), hit.cend(), false) == hit.cend();
     }
     
     template <typename D, typename R>
     bool
     BinaryRelation<D, R>::left_total() const
     {
-        return _from == domain() ;
+        for (auto&& row : *_relation)
+            if (row.empty())
+                return false;
+        return true;
     }
     
+    // Aftersets that meet must coincide
     template <typename D, typename R>
     bool
     BinaryRelation<D, R>::difunctional() const
     {
         if(functional())
             return true ;
-        auto d = domain();
-        auto pairs = make_pairs(d, d);
-        for (const auto& pair: pairs)
-        {
-            auto afterset1 = afterset(pair.first);
-            auto afterset2 = afterset(pair.second);
-            decltype(afterset1) output ;
-            std::set_intersection(afterset1.begin(), afterset1.end(), afterset2.begin(), afterset2.end(), output.begin());
-            if (output.size() > 0 && afterset1 != afterset2)
-                return false;
-        }
+        std::vector<id_type> owner(_rsize(), npos);
+        for (id_type x = 0; x < _relation->size(); ++x)
+            for (auto&& element : (*_relation)[x])
+            {
+                if (owner[element] == npos)
+                    owner[element] = x ;
+                else if ((*_relation)[owner[element]] != (*_relation)[x])
+                    return false;
+            }
         return true;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::reflexive() const 
     {
-        if (_from == _codomain)
-        {
-            return zebra::all(_relation, [this](auto x) -> bool {
-                return this->exists(x, x);
+        if (_homogenous())
+            return all_ids(_dsize(), [this](id_type x) -> bool {
+                return this->_exists(x, x);
             });
-        }
         return false;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::irreflexive() const 
     {
-        if (_from == _codomain)
-        {
-            return !zebra::any(_relation, [this](auto x) {
-                return this->exists(x, x);
+        if (_homogenous())
+            return !any_ids(_dsize(), [this](id_type x) -> bool {
+                return this->_exists(x, x);
             });
-        }
         return false;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::symmetric() const
     {
-        if (_from == _codomain)
+        if (_homogenous())
         {
-            return zebra::all2(_relation, [this](auto x, auto y) -> bool {
-                return this->exists(y, x);
-            });
+            for (id_type x = 0; x < _relation->size(); ++x)
+                for (auto&& y : (*_relation)[x])
+                    if (!_exists(y, x))
+                        return false;
+            return true;
         }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::asymmetric() const
     {
-        if (_from == _codomain)
+        if (_homogenous())
         {
-            return !zebra::any2(_relation, [this](auto x, auto y) -> bool {
-                return this->exists(y, x);
-            });
+            for (id_type x = 0; x < _relation->size(); ++x)
+                for (auto&& y : (*_relation)[x])
+                    if (_exists(y, x))
+                        return false;
+            return true;
         }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::antisymmetric() const
     {
-        if (_from == _codomain)
+        if (_homogenous())
         {
-            return zebra::all2(_relation, [this](auto x, auto y) -> bool {
-                return this->exists(y, x) ? x == y : true;
-            });
+            for (id_type x = 0; x < _relation->size(); ++x)
+                for (auto&& y : (*_relation)[x])
+                    if (y != x && _exists(y, x))
+                        return false;
+            return true;
         }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::total() const
     {
-        if (_from == _codomain)
-        {
-            return zebra::all2(_from, [this](auto x, auto y) -> bool {
-                return this->exists(x, y) || this->exists(y, x);
+        if (_homogenous())
+            return all2_ids(_dsize(), [this](id_type x, id_type y) -> bool {
+                return this->_exists(x, y) || this->_exists(y, x);
             });
-        }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::trichotomous() const
     {
-        if (_from == _codomain)
-        {
-            return zebra::all2(_from, [this](auto x, auto y) -> bool {
-                return this->exists(x, y) || this->exists(y, x) || x == y;
+        if (_homogenous())
+            return all2_ids(_dsize(), [this](id_type x, id_type y) -> bool {
+                return this->_exists(x, y) || this->_exists(y, x) || x == y;
             });
-        }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::serial() const
     {
-        if (_from == _codomain)
-        {
-            return domain() == _from ;
-        }
+        if (_homogenous())
+            return left_total();
         return false ;
     }
     
     template <typename D, typename R>
-    HOM(bool)
+    HOM_DEF(bool)
     BinaryRelation<D, R>::transitive() const
     {
-        if (_from == _codomain)
+        if (_homogenous())
         {
-            return zebra::all3(_relation, [this](auto x, auto y, auto z) -> bool {
-                return this->exists(x, y) && this->exists(y, z) && this->exists(x, z);
-            });
+            for (id_type x = 0; x < _relation->size(); ++x)
+                for (auto&& y : (*_relation)[x])
+                    for (auto&& z : (*_relation)[y])
+                        if (!_exists(x, z))
+                            return false;
+            return true;
         }
         return false ;
     }
     
     template <typename D, typename R>
-    HOM2(typename BinaryRelation<D, R>::qset_type)
+    HOM_DEF2(typename BinaryRelation<D, R>::qset_type)
     BinaryRelation<D, R>::quotient_set() const
     {
         Set<Set<R>> qs ;
-        if (equivalence())
-            for (const auto& element : domain())
-                qs.insert(afterset(element));
+        if (!equivalence())
+            return qs ;
+        std::vector<bool> seen(_dsize(), false);
+        for (id_type x = 0; x < _relation->size(); ++x)
+            if (!seen[x])
+            {
+                for (auto&& y : (*_relation)[x])
+                    seen[y] = true ;
+                qs.insert(_rsym->values((*_relation)[x]));
+            }
         return qs ;
     }
     
+    // Depth first search from every element, O(n (n + m)) id operations
     template <typename D, typename R>
-    HOM2(BinaryRelation<D, R>)
+    HOM_DEF2(BinaryRelation<D, R>)
     BinaryRelation<D, R>::transitive_closure() const 
     {
-        BinaryRelation<D, R> result = *this ;
-        for (auto&& pair : result._relation)
-            for (auto&& element : pair.second)
-                if (result._relation.count(element) > 0)
-                {
-                    auto add = result._relation.at(element);
-                    result.add(*pair.first, add.cbegin(), add.cend());
-                }
+        BinaryRelation<D, R> result ;
+        result._share(*this);
+        std::vector<id_type> stack ;
+        for (id_type x = 0; x < _relation->size(); ++x)
+        {
+            auto& reach = result._relation.write()[x];
+            stack.assign((*_relation)[x].begin(), (*_relation)[x].end());
+            while (!stack.empty())
+            {
+                auto y = stack.back();
+                stack.pop_back();
+                if (reach.count(y) > 0)
+                    continue;
+                reach.insert(y);
+                for (auto&& z : (*_relation)[y])
+                    if (reach.count(z) == 0)
+                        stack.push_back(z);
+            }
+        }
         return std::move(result);
     }
     
     template <typename D, typename R>
-    HOM2(BinaryRelation<D, R>)
+    HOM_DEF2(BinaryRelation<D, R>)
     BinaryRelation<D, R>::reflexive_closure() const 
     {
         BinaryRelation<D, R> result = *this ;
-        for (auto&& pair : result._relation)
-            result.add(*pair.first, pair.first);
+        if (_homogenous())
+            for (id_type x = 0; x < result._relation->size(); ++x)
+                result._relation.write()[x].insert(x);
         return std::move(result);
     }
     
     template <typename D, typename R>
-    HOM2(BinaryRelation<D, R>)
+    HOM_DEF2(BinaryRelation<D, R>)
     BinaryRelation<D, R>::reflexive_reduction() const 
     {
         BinaryRelation<D, R> result = *this ;
-        for (auto&& pair : result._relation)
-        {
-            auto next = result._relation[pair.first];
-            next.erase(std::find(result._codomain.cbegin(), result._codomain.cend(), pair.first));
-            result._relation[pair.first] = next ;
-        }
+        if (_homogenous())
+            for (id_type x = 0; x < result._relation->size(); ++x)
+                result._relation.write()[x].erase(x);
         return std::move(result);
     }
     
     template <typename D, typename R>
-    HOM3(Mapping<D, typename BinaryRelation<D, R>::qset_type>)
+    HOM_DEF2(BinaryRelation<D, R>)
+    BinaryRelation<D, R>::restrict(const Set<D>& set) const 
+    {
+        BinaryRelation<D, R> result ;
+        Set<D> from ;
+        for (auto&& element : set)
+            if (_dsym->contains(element))
+                from.insert(element);
+        result._intern(from, from);
+        auto ids = translation(*result._dsym, *_dsym);
+        auto back = translation(*_dsym, *result._dsym);
+        for (id_type x = 0; x < result._relation->size(); ++x)
+            for (auto&& y : (*_relation)[ids[x]])
+                if (back[y] != npos)
+                    result._relation.write()[x].insert(back[y]);
+        return std::move(result);
+    }
+    
+    // Classes are interned once, every element then maps to a class id
+    template <typename D, typename R>
+    HOM_DEF2(Mapping<D, Set<R>>)
     BinaryRelation<D, R>::projection() const 
     {
-        Mapping<D, qset_type> project ;
-        project._codomain = quotient_set();
-        project._from = domain();
-        for (auto&& element : project._from)
-            project.add(element, equivalence_class(element));
+        Mapping<D, Set<R>> project ;
+        if (!equivalence())
+            return std::move(project);
+        project._dsym = _dsym ;
+        project._rsym = std::make_shared<Interner<Set<R>>>();
+        project._relation = typename Mapping<D, Set<R>>::rel_type(_dsize());
+        for (id_type x = 0; x < _relation->size(); ++x)
+            if ((*project._relation)[x].empty())
+            {
+                auto cls = project._rsym->intern(_rsym->values((*_relation)[x]));
+                for (auto&& y : (*_relation)[x])
+                    project._relation.write()[y].insert(cls);
+            }
         return std::move(project);
     }
 
     template <typename D, typename R>
-    HOM(Set<R>)
+    HOM_DEF(Set<R>)
     BinaryRelation<D, R>::equivalence_class(const D& element) const
     {
         Set<R> result ;
@@ -700,59 +820,66 @@ namespace zebra
     std::ostream& 
     operator<<(std::ostream& stream, const BinaryRelation<A, B>& br)
     {
-        for (auto it = br.cbegin(); it != br.cend(); ++it)
-        {
-            stream << *it->first << " : [ ";
-            for (const auto& element : it->second)
-                stream << *element << " ";
-            stream << "]\n";
-        }
+        for (id_type x = 0; x < br._relation->size(); ++x)
+            if (!(*br._relation)[x].empty())
+            {
+                stream << (*br._dsym)[x] << " : [ ";
+                for (const auto& element : (*br._relation)[x])
+                    stream << (*br._rsym)[element] << " ";
+                stream << "]\n";
+            }
         return stream ;
     }
     
     template <typename D, typename R> BinaryRelation<D, R> intersection(const BinaryRelation<D, R>& lhs, const BinaryRelation<D, R>& rhs)
     {
         BinaryRelation<D, R> result ;
-        result._codomain = lhs._codomain;
-        result._from = lhs._from ;
-        auto ck = common_keys<D, decltype(lhs.cbegin())>(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
-        for (auto&& key : ck)
-        {
-            auto set = intersection_itr(lhs.at(key), rhs.at(key));
-            for (auto&& element : set)
-                result.add(key, element);
-        }     
+        result._share(lhs);
+        auto dmap = translation(*lhs._dsym, *rhs._dsym);
+        auto rmap = translation(*lhs._rsym, *rhs._rsym);
+        for (id_type x = 0; x < lhs._relation->size(); ++x)
+            if (dmap[x] != npos)
+                for (auto&& y : (*lhs._relation)[x])
+                    if (rmap[y] != npos && rhs._exists(dmap[x], rmap[y]))
+                        result._relation.write()[x].insert(y);
         return result;
     }
     
     template <typename D, typename R> BinaryRelation<D, R> combination(const BinaryRelation<D, R>& lhs, const BinaryRelation<D, R>& rhs)
     {
-        BinaryRelation<D, R> result ;
-        result._codomain = lhs._codomain;
-        result._from = lhs._from ;
-        auto ck = all_keys<D, decltype(lhs.cbegin())>(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
-        for (auto&& key : ck)
-        {
-            auto set = combination_itr(lhs.at(key), rhs.at(key));
-            for (auto&& element : set)
-                result.add(key, element);
-        }
+        BinaryRelation<D, R> result = lhs ;
+        auto dmap = translation(*rhs._dsym, *lhs._dsym);
+        auto rmap = translation(*rhs._rsym, *lhs._rsym);
+        for (id_type x = 0; x < rhs._relation->size(); ++x)
+            if (dmap[x] != npos)
+                for (auto&& y : (*rhs._relation)[x])
+                    if (rmap[y] != npos)
+                        result._relation.write()[dmap[x]].insert(rmap[y]);
         return result;
     }
     
     template <typename A, typename B, typename C> BinaryRelation<A, C> composition(const BinaryRelation<A, B>& lhs, const BinaryRelation<B, C>& rhs)
     {
         BinaryRelation<A, C> result ;
-        result._from = lhs._from ;
-        result._codomain = rhs._codomain ;
-        for (auto&& pair : lhs._relation)
-            for (auto&& element : pair.second)
-                if (rhs._relation.count(rhs._itr(*element)) > 0)
-                    for (auto&& ans : rhs._relation.at(element))
-                        result.add(result._itr(pair.first), ans);
+        result._dsym = lhs._dsym ;
+        result._rsym = share_symbols(lhs._dsym, rhs._rsym);
+        result._relation = typename BinaryRelation<A, C>::rel_type(lhs._dsize());
+        auto dmap = translation(*lhs._dsym, *result._dsym);
+        auto middle = translation(*lhs._rsym, *rhs._dsym);
+        auto rmap = translation(*rhs._rsym, *result._rsym);
+        for (id_type x = 0; x < lhs._relation->size(); ++x)
+            for (auto&& y : (*lhs._relation)[x])
+                if (middle[y] != npos)
+                    for (auto&& z : (*rhs._relation)[middle[y]])
+                        result._relation.write()[dmap[x]].insert(rmap[z]);
         return result ;
     }
     
+    template <typename D, typename R> bool operator==(const BinaryRelation<D, R>& lhs, const BinaryRelation<D, R>& rhs)
+    {
+        return lhs.contains(rhs) && rhs.contains(lhs);
+    }
+    
     template <typename A, typename B, typename C> BinaryRelation<A, C> operator*(const BinaryRelation<A, B>& lhs, const BinaryRelation<B, C>& rhs)
     {
         return composition(lhs, rhs);
@@ -770,8 +897,8 @@ namespace zebra
     
     template <typename D, typename R> BinaryRelation<D, R> operator^(const BinaryRelation<D, R>& lhs, std::size_t power)
     {
-        decltype(lhs) result = lhs ;
-        for (auto i = 2; i <= power; ++i)
+        BinaryRelation<D, R> result = lhs ;
+        for (std::size_t i = 2; i <= power; ++i)
             result = result * lhs ;
         return result ;
     }
@@ -789,4 +916,4 @@ namespace zebra
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,253 @@
+#ifndef ZEBRA_ROW
+#define ZEBRA_ROW
+
+#include "intern.hpp"
+#include "bitset.hpp"
+#include <iterator>
+
+namespace zebra
+{
+    // A set of ids sized for adjacency rows, held in one 64 bit word whose
+    // two low bits are the mode. One id lives inside the word itself,
+    // larger rows move to a sorted vector and rows dense enough to beat
+    // the vector (one bit per id of the span versus 32 bits per element)
+    // become a Bitset, both behind the pointer kept in the word. An empty
+    // or single target row, the common case of a function, is 8 bytes.
+    // Iteration is always ascending.
+    class Row
+    {
+    public:
+
+        static const id_type inline_capacity = 1u ;
+        static const id_type bitset_threshold = 32u ;
+        static const id_type bitset_minimum = 16u ;
+
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category ;
+            typedef id_type                   value_type ;
+            typedef std::ptrdiff_t            difference_type ;
+            typedef const id_type*            pointer ;
+            typedef id_type                   reference ;
+
+            const_iterator(const Row* row, std::size_t pos) : _row{row}, _pos{pos} {}
+
+            id_type operator*() const { return _row->_at(_pos); }
+            const_iterator& operator++() { _pos = _row->_advance(_pos); return *this; }
+            const_iterator  operator++(int) { auto copy = *this; ++(*this); return copy; }
+            bool operator==(const const_iterator& rhs) const { return _pos == rhs._pos; }
+            bool operator!=(const const_iterator& rhs) const { return _pos != rhs._pos; }
+
+        private:
+            const Row*  _row ;
+            std::size_t _pos ;
+        };
+
+        typedef const_iterator iterator ;
+
+        Row() : _word{INLINE} {}
+        Row(const Row&);
+        Row(Row&&) noexcept;
+        ~Row() { _release(); }
+
+        Row& operator=(Row);
+
+        std::size_t    size() const ;
+        bool           empty() const { return size() == 0u; }
+        std::size_t    count(id_type) const ;
+        bool           insert(id_type);
+        bool           erase(id_type);
+        void           clear() { _release(); _word = INLINE; }
+        const_iterator begin() const { return const_iterator(this, _first()); }
+        const_iterator end() const { return const_iterator(this, _last()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        bool operator==(const Row&) const ;
+        bool operator!=(const Row& rhs) const { return !(*this == rhs); }
+
+        friend void swap(Row& lhs, Row& rhs) noexcept
+        {
+            std::swap(lhs._word, rhs._word);
+        }
+
+    private:
+
+        // INLINE keeps the size in bit 2 and the id in the high half
+        enum Mode : uint64_t { INLINE = 0u, VECTOR = 1u, BITSET = 2u };
+
+        struct Dense
+        {
+            Bitset   bits ;
+            uint32_t size ;
+        };
+
+        static_assert(sizeof(void*) <= sizeof(uint64_t), "Pointers must fit in a row...");
+        static_assert(alignof(std::vector<id_type>) >= 4u && alignof(Dense) >= 4u, "Rows need two free pointer bits...");
+
+        Mode                  _mode() const { return static_cast<Mode>(_word & 3u); }
+        id_type               _id() const { return static_cast<id_type>(_word >> 32); }
+        std::vector<id_type>* _vector() const { return reinterpret_cast<std::vector<id_type>*>(static_cast<uintptr_t>(_word & ~uint64_t(3u))); }
+        Dense*                _dense() const { return reinterpret_cast<Dense*>(static_cast<uintptr_t>(_word & ~uint64_t(3u))); }
+        static uint64_t       _single(id_type id) { return (static_cast<uint64_t>(id) << 32) | 4u | INLINE; }
+        static uint64_t       _tag(const void* p, Mode mode) { return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p)) | mode; }
+
+        id_type     _at(std::size_t pos) const ;
+        std::size_t _advance(std::size_t pos) const ;
+        std::size_t _first() const { return _mode() == BITSET ? _dense()->bits.next(0) : 0u; }
+        std::size_t _last() const { return _mode() == BITSET ? _dense()->bits.size() : size(); }
+        void        _release();
+        void        _to_bitset();
+
+        uint64_t _word ;
+    };
+
+    inline
+    Row::Row(const Row& copy)
+        : _word{copy._word}
+    {
+        if (_mode() == VECTOR)
+            _word = _tag(new std::vector<id_type>(*copy._vector()), VECTOR);
+        else if (_mode() == BITSET)
+            _word = _tag(new Dense(*copy._dense()), BITSET);
+    }
+
+    inline
+    Row::Row(Row&& move) noexcept
+        : _word{move._word}
+    {
+        move._word = INLINE ;
+    }
+
+    inline Row&
+    Row::operator=(Row copy)
+    {
+        swap(*this, copy);
+        return *this ;
+    }
+
+    inline void
+    Row::_release()
+    {
+        if (_mode() == VECTOR)
+            delete _vector();
+        else if (_mode() == BITSET)
+            delete _dense();
+    }
+
+    inline std::size_t
+    Row::size() const
+    {
+        switch (_mode())
+        {
+            case INLINE: return (_word >> 2) & 1u ;
+            case VECTOR: return _vector()->size();
+            default:     return _dense()->size ;
+        }
+    }
+
+    inline id_type
+    Row::_at(std::size_t pos) const
+    {
+        switch (_mode())
+        {
+            case INLINE: return _id();
+            case VECTOR: return (*_vector())[pos];
+            default:     return static_cast<id_type>(pos);
+        }
+    }
+
+    inline std::size_t
+    Row::_advance(std::size_t pos) const
+    {
+        return _mode() == BITSET ? _dense()->bits.next(pos + 1u) : pos + 1u ;
+    }
+
+    inline std::size_t
+    Row::count(id_type id) const
+    {
+        switch (_mode())
+        {
+            case INLINE:
+                return _word == _single(id) ? 1u : 0u ;
+            case VECTOR:
+                return std::binary_search(_vector()->cbegin(), _vector()->cend(), id) ? 1u : 0u ;
+            default:
+            {
+                const auto& bits = _dense()->bits ;
+                return id < bits.size() && bits.test(id) ? 1u : 0u ;
+            }
+        }
+    }
+
+    inline void
+    Row::_to_bitset()
+    {
+        auto vector = _vector();
+        auto dense = new Dense{Bitset(vector->back() + 1u), static_cast<uint32_t>(vector->size())};
+        for (auto&& id : *vector)
+            dense->bits.set(id);
+        delete vector ;
+        _word = _tag(dense, BITSET);
+    }
+
+    inline bool
+    Row::insert(id_type id)
+    {
+        if (count(id))
+            return false ;
+        if (_mode() == INLINE)
+        {
+            if (size() < inline_capacity)
+            {
+                _word = _single(id);
+                return true ;
+            }
+            auto vector = new std::vector<id_type>(1u, _id());
+            _word = _tag(vector, VECTOR);
+        }
+        if (_mode() == VECTOR)
+        {
+            auto& vector = *_vector();
+            vector.insert(std::lower_bound(vector.begin(), vector.end(), id), id);
+            if (vector.size() >= bitset_minimum && vector.size() * bitset_threshold >= static_cast<std::size_t>(vector.back()) + 1u)
+                _to_bitset();
+            return true ;
+        }
+        auto& dense = *_dense();
+        if (id >= dense.bits.size())
+            dense.bits.resize(std::max<std::size_t>(id + 1u, 2u * dense.bits.size()));
+        dense.bits.set(id);
+        ++dense.size ;
+        return true ;
+    }
+
+    inline bool
+    Row::erase(id_type id)
+    {
+        if (!count(id))
+            return false ;
+        switch (_mode())
+        {
+            case INLINE:
+                _word = INLINE ;
+                break ;
+            case VECTOR:
+                _vector()->erase(std::lower_bound(_vector()->begin(), _vector()->end(), id));
+                break ;
+            default:
+                _dense()->bits.reset(id);
+                --_dense()->size ;
+        }
+        return true ;
+    }
+
+    inline bool
+    Row::operator==(const Row& rhs) const
+    {
+        return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+    }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define ZEBRA_SEMIGROUP
 
 #include "magma.hpp"
+#include "sub.hpp"
 
 namespace zebra
 {
@@ -14,6 +15,7 @@ namespace zebra
         using typename Magma<T>::param_type;
         using typename Magma<T>::table_type;
         using typename Magma<T>::iter ;
+        using typename Magma<T>::cells_type ;
         using Magma<T>::idempotent;
         using Magma<T>::commutative;
         using Magma<T>::associative;
@@ -22,6 +24,7 @@ namespace zebra
         SemiGroup(const table_type&, const Set<T>&);
         SemiGroup(iter, iter, const Set<T>&);
         SemiGroup(bin_op_type&&, const Set<T>&);
+        SemiGroup(const cells_type&, const SharedInterner<T>&);
         
         bool band() const { return idempotent(); }
         bool semilattice() const { return band() && commutative(); }
@@ -40,13 +43,20 @@ namespace zebra
 
         Set<T> Hclass(T, T) const ;
         
+        Closure<T, SemiGroup> generate(const std::vector<T>& generators) const { return Closure<T, SemiGroup>{*this, generators}; }
+        
     protected:
-        using Magma<T>::_set ;
-        using Magma<T>::_table ;
-        using Magma<T>::_itr ;
+        using Magma<T>::_order ;
+        using Magma<T>::_op ;
+        using Magma<T>::_id ;
+
+        std::vector<bool> _left_ideal(id_type) const ;
+        std::vector<bool> _right_ideal(id_type) const ;
         
         void check() throw(Exception);
     };
+
+    template <typename T> using Subsemigroup = Sub<T, SemiGroup>;
     
     template <typename T>
     void
@@ -77,15 +87,22 @@ namespace zebra
         check();
     }
 
+    template <typename T>
+    SemiGroup<T>::SemiGroup(const cells_type& cells, const SharedInterner<T>& symbols)
+        : Magma<T>{cells, symbols}
+    {
+        check();
+    }
+
     template <typename T>
     bool
     SemiGroup<T>::regular() const 
     {
-        for (auto&& x : _set)
+        for (id_type x = 0; x < _order; ++x)
         {
             bool exists = false ;
-            for (auto&& y : _set)
-                if (this->at(x, this->at(y, x)) == x && this->at(y, this->at(x, y)) == y)
+            for (id_type y = 0; y < _order; ++y)
+                if (_op(x, _op(y, x)) == x && _op(y, _op(x, y)) == y)
                 {
                     exists = true ;
                     break ;
@@ -96,61 +113,66 @@ namespace zebra
         return true;
     }
 
+    // S^1 a, as a membership vector over ids
+    template <typename T>
+    std::vector<bool>
+    SemiGroup<T>::_left_ideal(id_type a) const
+    {
+        std::vector<bool> ideal(_order, false);
+        ideal[a] = true ;
+        for (id_type x = 0; x < _order; ++x)
+            ideal[_op(x, a)] = true ;
+        return ideal ;
+    }
+
+    // a S^1, as a membership vector over ids
+    template <typename T>
+    std::vector<bool>
+    SemiGroup<T>::_right_ideal(id_type a) const
+    {
+        std::vector<bool> ideal(_order, false);
+        ideal[a] = true ;
+        for (id_type x = 0; x < _order; ++x)
+            ideal[_op(a, x)] = true ;
+        return ideal ;
+    }
+
     template <typename T>
     bool
     SemiGroup<T>::L(T a, T b) const
     {
-        if (_set.find(a) == _set.end() || _set.find(b) == _set.end())
+        if (!this->contains(a) || !this->contains(b))
             return false;
-        Set<T> lhs, rhs ;
-        lhs.insert(a);
-        rhs.insert(b);
-        for (auto&& x : _set)
-        {
-            lhs.insert(this->at(x, a));
-            rhs.insert(this->at(x, b));
-        }
-        return lhs == rhs ;
+        return _left_ideal(_id(a)) == _left_ideal(_id(b));
     }
 
     template <typename T>
     bool
     SemiGroup<T>::R(T a, T b) const
     {
-        if (_set.find(a) == _set.end() || _set.find(b) == _set.end())
+        if (!this->contains(a) || !this->contains(b))
             return false;
-        Set<T> lhs, rhs ;
-        lhs.insert(a);
-        rhs.insert(b);
-        for (auto&& x : _set)
-        {
-            lhs.insert(this->at(a, x));
-            rhs.insert(this->at(b, x));
-        }
-        return lhs == rhs ;
+        return _right_ideal(_id(a)) == _right_ideal(_id(b));
     }
 
     template <typename T>
     bool
     SemiGroup<T>::J(T a, T b) const
     {
-        if (_set.find(a) == _set.end() || _set.find(b) == _set.end())
+        if (!this->contains(a) || !this->contains(b))
             return false;
-        Set<T> lhs, rhs ;
-        lhs.insert(a);
-        rhs.insert(b);
-        for (auto&& x : _set)
-        {
-            lhs.insert(this->at(x, a));
-            lhs.insert(this->at(a, x));
-            lhs.insert(this->at(x, this->at(a, x)));
-            rhs.insert(this->at(x, b));
-            rhs.insert(this->at(b, x));
-            rhs.insert(this->at(x, this->at(b, x)));
-        }
-        return lhs == rhs ;
+        auto ideal = [this] (id_type a) {
+            std::vector<bool> result = _left_ideal(a);
+            for (id_type x = 0; x < _order; ++x)
+            {
+                result[_op(a, x)] = true ;
+                result[_op(x, _op(a, x))] = true ;
+            }
+            return result ;
+        };
+        return ideal(_id(a)) == ideal(_id(b));
     }
 
 }
 
-#endif
\ No newline at end of file
+#endif
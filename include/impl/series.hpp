@@ -0,0 +1,193 @@
+#ifndef ZEBRA_SERIES
+#define ZEBRA_SERIES
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // A few generators of a subgroup, each outside the closure of those
+    // before it, so at most log2 |H| of them
+    template <typename T>
+    std::vector<id_type>
+    Group<T>::_generators(const Bitset& members) const
+    {
+        std::vector<id_type> result ;
+        Bitset closure(_order);
+        closure.set(_identity_id);
+        std::vector<id_type> queue(1u, _identity_id);
+        members.each([&](std::size_t h) {
+            auto g = static_cast<id_type>(h);
+            if (closure.test(g))
+                return ;
+            result.push_back(g);
+            for (std::size_t k = 0; k < queue.size(); ++k)
+                for (auto&& s : result)
+                {
+                    auto y = this->_op(queue[k], s);
+                    if (!closure.test(y))
+                    {
+                        closure.set(y);
+                        queue.push_back(y);
+                    }
+                }
+        });
+        return result ;
+    }
+
+    // The smallest subgroup holding the generators and closed under
+    // conjugation by the conjugators. Only the conjugates of generators
+    // are tested, every new one outside joins the generators and the
+    // closure is extended, which happens at most log2 |G| times.
+    template <typename T>
+    Bitset
+    Group<T>::_normal_closure(std::vector<id_type> generators, const std::vector<id_type>& conjugators) const
+    {
+        Bitset members(_order);
+        members.set(_identity_id);
+        std::vector<id_type> queue(1u, _identity_id), kept ;
+        auto extend = [&](id_type g) {
+            if (members.test(g))
+                return ;
+            kept.push_back(g);
+            for (std::size_t k = 0; k < queue.size(); ++k)
+                for (auto&& s : kept)
+                {
+                    auto y = this->_op(queue[k], s);
+                    if (!members.test(y))
+                    {
+                        members.set(y);
+                        queue.push_back(y);
+                    }
+                }
+        };
+        for (auto&& g : generators)
+            extend(g);
+        for (std::size_t i = 0; i < kept.size(); ++i)
+            for (auto&& c : conjugators)
+                extend(_conj(kept[i], c));
+        return members ;
+    }
+
+    // [H, K] is the normal closure in <H, K> of the commutators of their
+    // generators, O(|[H, K]| log |G|) lookups instead of |H| |K| products
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::commutator(const Sub<T, Group>& lhs, const Sub<T, Group>& rhs) const
+    {
+        if (&lhs.parent().cells() != &this->cells() || &rhs.parent().cells() != &this->cells())
+            return commutator(Subgroup<T>{*this, lhs.elements()}, Subgroup<T>{*this, rhs.elements()});
+        auto left = _generators(lhs.members()), right = _generators(rhs.members());
+        std::vector<id_type> commutators, conjugators = left ;
+        for (auto&& x : left)
+            for (auto&& y : right)
+                commutators.push_back(_op(_op(_inv(x), _inv(y)), _op(x, y)));
+        conjugators.insert(conjugators.end(), right.begin(), right.end());
+        return Subgroup<T>{*this, _normal_closure(std::move(commutators), conjugators)};
+    }
+
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::derived_subgroup() const
+    {
+        const auto& generators = generating_set();
+        std::vector<id_type> commutators ;
+        for (auto&& x : generators)
+            for (auto&& y : generators)
+                commutators.push_back(_op(_op(_inv(x), _inv(y)), _op(x, y)));
+        return Subgroup<T>{*this, _normal_closure(std::move(commutators), generators)};
+    }
+
+    // G > G' > G'' > ... down to the first perfect term
+    template <typename T>
+    std::vector<Sub<T, Group>>
+    Group<T>::derived_series() const
+    {
+        Bitset all(_order);
+        for (id_type x = 0; x < _order; ++x)
+            all.set(x);
+        std::vector<Sub<T, Group>> result(1u, Subgroup<T>{*this, all});
+        for (auto next = derived_subgroup(); next.size() < result.back().size(); next = commutator(next, next))
+            result.push_back(next);
+        return result ;
+    }
+
+    // G > [G, G] > [[G, G], G] > ... until it stops descending
+    template <typename T>
+    std::vector<Sub<T, Group>>
+    Group<T>::lower_central_series() const
+    {
+        Bitset all(_order);
+        for (id_type x = 0; x < _order; ++x)
+            all.set(x);
+        Subgroup<T> whole{*this, all};
+        std::vector<Sub<T, Group>> result(1u, whole);
+        for (auto next = derived_subgroup(); next.size() < result.back().size(); next = commutator(next, whole))
+            result.push_back(next);
+        return result ;
+    }
+
+    // 1 < Z(G) < Z2(G) < ..., x lying in the next term when its commutator
+    // with every generator of G lies in the current one
+    template <typename T>
+    std::vector<Sub<T, Group>>
+    Group<T>::upper_central_series() const
+    {
+        const auto& generators = generating_set();
+        Bitset current(_order);
+        current.set(_identity_id);
+        std::vector<Sub<T, Group>> result(1u, Subgroup<T>{*this, current});
+        for (;;)
+        {
+            Bitset next(_order);
+            for (id_type x = 0; x < _order; ++x)
+            {
+                bool central = true ;
+                for (auto&& g : generators)
+                    if (!(central = current.test(_op(_op(_inv(x), _inv(g)), _op(x, g)))))
+                        break ;
+                if (central)
+                    next.set(x);
+            }
+            if (next == current)
+                return result ;
+            current = next ;
+            result.push_back(Subgroup<T>{*this, current});
+        }
+    }
+
+    template <typename T>
+    bool
+    Group<T>::solvable() const
+    {
+        return derived_series().back().size() == 1u ;
+    }
+
+    template <typename T>
+    bool
+    Group<T>::nilpotent() const
+    {
+        return lower_central_series().back().size() == 1u ;
+    }
+
+    template <typename T>
+    std::size_t
+    Group<T>::derived_length() const
+    {
+        auto series = derived_series();
+        if (series.back().size() != 1u)
+            throw Exception(DOES_NOT_EXIST, "The group is not solvable...");
+        return series.size() - 1u ;
+    }
+
+    template <typename T>
+    std::size_t
+    Group<T>::nilpotency_class() const
+    {
+        auto series = lower_central_series();
+        if (series.back().size() != 1u)
+            throw Exception(DOES_NOT_EXIST, "The group is not nilpotent...");
+        return series.size() - 1u ;
+    }
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef ZEBRA_SUB
+#define ZEBRA_SUB
+
+#include "intern.hpp"
+#include "bitset.hpp"
+
+namespace zebra
+{
+    // A substructure viewed through its parent: a membership bitset over the
+    // parent's ids plus the parent itself, whose table and interner are
+    // shared rather than copied. Laws such as associativity are inherited
+    // from the parent, only closure has to be verified for a view.
+    template <typename T, template <typename> class Parent>
+    class Sub
+    {
+    public:
+
+        Sub() {}
+        Sub(const Parent<T>&, const Bitset&);
+        Sub(const Parent<T>&, const Set<T>&);
+
+        const Parent<T>& parent() const { return _parent; }
+        const Bitset&    members() const { return _members; }
+        std::size_t      size() const { return _size; }
+        bool             member(id_type id) const { return id < _members.size() && _members.test(id); }
+        bool             contains(const T&) const ;
+        Set<T>           elements() const ;
+        T                at(const T&, const T&) const ;
+        T                operator()(const T& x, const T& y) const { return at(x, y); }
+        bool             closed() const ;
+        Parent<T>        materialize() const ;
+
+        bool operator==(const Sub& rhs) const { return _members == rhs._members && &_parent.cells() == &rhs._parent.cells(); }
+        bool operator!=(const Sub& rhs) const { return !(*this == rhs); }
+
+    protected:
+
+        id_type _op(id_type x, id_type y) const { return _parent.cells()[static_cast<std::size_t>(x) * _parent.size() + y]; }
+
+        Parent<T>   _parent ;
+        Bitset      _members ;
+        std::size_t _size = 0u ;
+    };
+
+    // The substructure generated by a list of elements: a breadth first
+    // closure under right multiplication by the generators with bitset
+    // membership, O(|H| |gens|) lookups. The search tree is kept, each
+    // member remembers the member and the generator it was first reached
+    // from, so word() spells any member as a product of generators. A
+    // unital closure starts from the identity, whose word is empty.
+    template <typename T, template <typename> class Parent>
+    class Closure : public Sub<T, Parent>
+    {
+    public:
+
+        Closure() {}
+        Closure(const Parent<T>&, const std::vector<T>&, id_type = npos);
+
+        const std::vector<T>&    generators() const { return _generators; }
+        std::vector<std::size_t> word(const T&) const ;
+        T                        evaluate(const std::vector<std::size_t>&) const ;
+
+    protected:
+
+        using Sub<T, Parent>::_parent ;
+        using Sub<T, Parent>::_members ;
+        using Sub<T, Parent>::_size ;
+        using Sub<T, Parent>::_op ;
+
+        std::vector<T>       _generators ;
+        std::vector<id_type> _from, _via ;
+        id_type              _identity = npos ;
+    };
+
+    template <typename T> using Subset = Sub<T, Set>;
+
+    template <typename T, template <typename> class Parent>
+    Sub<T, Parent>::Sub(const Parent<T>& parent, const Bitset& members)
+        : _parent{parent}, _members{members}
+    {
+        if (_members.size() != _parent.size())
+            throw Exception(NOT_CONFORMANT, "Membership does not match the parent structure...");
+        _size = _members.count();
+    }
+
+    template <typename T, template <typename> class Parent>
+    Sub<T, Parent>::Sub(const Parent<T>& parent, const Set<T>& set)
+        : _parent{parent}, _members(parent.size())
+    {
+        for (auto&& element : set)
+        {
+            auto id = _parent.symbols().find(element);
+            if (id == npos)
+                throw Exception(NOT_A_MEMBER, "The value is not a member of the parent structure...");
+            _members.set(id);
+        }
+        _size = set.size();
+    }
+
+    template <typename T, template <typename> class Parent>
+    bool
+    Sub<T, Parent>::contains(const T& value) const
+    {
+        auto id = _parent.symbols().find(value);
+        return id != npos && member(id);
+    }
+
+    template <typename T, template <typename> class Parent>
+    Set<T>
+    Sub<T, Parent>::elements() const
+    {
+        Set<T> result ;
+        _members.each([this, &result](std::size_t id) {
+            result.insert(this->_parent.symbols()[static_cast<id_type>(id)]);
+        });
+        return result ;
+    }
+
+    template <typename T, template <typename> class Parent>
+    T
+    Sub<T, Parent>::at(const T& x, const T& y) const
+    {
+        if (!contains(x) || !contains(y))
+            throw Exception(NOT_A_MEMBER, "Parameters not in the substructure...");
+        return _parent.at(x, y);
+    }
+
+    // O(|H|^2) table lookups, in a finite group closure alone already
+    // implies inverses, since the inverse of g is a power of g
+    template <typename T, template <typename> class Parent>
+    bool
+    Sub<T, Parent>::closed() const
+    {
+        std::vector<id_type> ids ;
+        ids.reserve(_size);
+        _members.each([&ids](std::size_t id) { ids.push_back(static_cast<id_type>(id)); });
+        for (auto&& x : ids)
+            for (auto&& y : ids)
+                if (!_members.test(_op(x, y)))
+                    return false ;
+        return true ;
+    }
+
+    template <typename T, template <typename> class Parent>
+    Closure<T, Parent>::Closure(const Parent<T>& parent, const std::vector<T>& generators, id_type identity)
+        : Sub<T, Parent>{parent, Bitset(parent.size())}, _generators{generators}, _identity{identity}
+    {
+        std::vector<id_type> gens, queue ;
+        for (auto&& g : generators)
+        {
+            auto id = parent.symbols().find(g);
+            if (id == npos)
+                throw Exception(NOT_A_MEMBER, "Generator not in the parent structure...");
+            gens.push_back(id);
+        }
+        _from.assign(parent.size(), npos);
+        _via.assign(parent.size(), npos);
+        auto reach = [&](id_type x, id_type from, id_type via) {
+            if (_members.test(x))
+                return ;
+            _members.set(x);
+            _from[x] = from ;
+            _via[x] = via ;
+            queue.push_back(x);
+        };
+        if (identity != npos)
+            reach(identity, npos, npos);
+        else
+            for (id_type i = 0; i < gens.size(); ++i)
+                reach(gens[i], npos, i);
+        for (std::size_t k = 0; k < queue.size(); ++k)
+            for (id_type i = 0; i < gens.size(); ++i)
+                reach(_op(queue[k], gens[i]), queue[k], i);
+        _size = queue.size();
+    }
+
+    // Generator indices read left to right, the product of which is the value
+    template <typename T, template <typename> class Parent>
+    std::vector<std::size_t>
+    Closure<T, Parent>::word(const T& value) const
+    {
+        auto id = _parent.symbols().find(value);
+        if (id == npos || !_members.test(id))
+            throw Exception(NOT_A_MEMBER, "The value is not a member of the substructure...");
+        std::vector<std::size_t> result ;
+        for (; id != npos && _via[id] != npos; id = _from[id])
+            result.push_back(_via[id]);
+        std::reverse(result.begin(), result.end());
+        return result ;
+    }
+
+    template <typename T, template <typename> class Parent>
+    T
+    Closure<T, Parent>::evaluate(const std::vector<std::size_t>& word) const
+    {
+        if (word.empty())
+        {
+            if (_identity == npos)
+                throw Exception(DOES_NOT_EXIST, "The empty word has no value without an identity...");
+            return _parent.symbols()[_identity];
+        }
+        T result = _generators.at(word.front());
+        for (std::size_t i = 1; i < word.size(); ++i)
+            result = _parent.at(result, _generators.at(word[i]));
+        return result ;
+    }
+
+    // A standalone structure on the members, with its own compact ids
+    template <typename T, template <typename> class Parent>
+    Parent<T>
+    Sub<T, Parent>::materialize() const
+    {
+        auto symbols = std::make_shared<Interner<T>>();
+        std::vector<id_type> ids, local(_parent.size(), npos);
+        symbols->reserve(_size);
+        _members.each([&](std::size_t id) {
+            local[id] = symbols->intern(_parent.symbols()[static_cast<id_type>(id)]);
+            ids.push_back(static_cast<id_type>(id));
+        });
+        typename Parent<T>::cells_type cells(ids.size() * ids.size(), npos);
+        for (std::size_t x = 0; x < ids.size(); ++x)
+            for (std::size_t y = 0; y < ids.size(); ++y)
+                cells[x * ids.size() + y] = local[_op(ids[x], ids[y])];
+        return Parent<T>{cells, symbols};
+    }
+}
+
+#endif
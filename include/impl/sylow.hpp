@@ -0,0 +1,169 @@
+#ifndef ZEBRA_SYLOW
+#define ZEBRA_SYLOW
+
+#include "group.hpp"
+
+namespace zebra
+{
+    // x normalises H when it conjugates every generator of H back into H
+    template <typename T>
+    Bitset
+    Group<T>::_normalizer(const Bitset& members, const std::vector<id_type>& generators) const
+    {
+        Bitset result(_order);
+        for (id_type x = 0; x < _order; ++x)
+        {
+            bool normalizes = true ;
+            for (auto&& h : generators)
+                if (!(normalizes = members.test(_conj(h, x))))
+                    break ;
+            if (normalizes)
+                result.set(x);
+        }
+        return result ;
+    }
+
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::normalizer(const Sub<T, Group>& view) const
+    {
+        if (&view.parent().cells() != &this->cells())
+            return normalizer(Subgroup<T>{*this, view.elements()});
+        return Subgroup<T>{*this, _normalizer(view.members(), _generators(view.members()))};
+    }
+
+    // A p-subgroup P short of Sylow has p dividing |N(P) : P|, so some x in
+    // N(P) has its p-part y outside P, and P<y> is again a p-subgroup,
+    // at least p times larger. Elements are scanned in id order, so the
+    // same table always yields the same subgroup.
+    template <typename T>
+    Bitset
+    Group<T>::_sylow(uint64_t prime, std::vector<id_type>& generators) const
+    {
+        auto primes = prime_divisors(prime);
+        if (primes.size() != 1u || primes.front() != prime)
+            throw Exception(NOT_CONFORMANT, "Argument is not a prime...");
+        uint64_t target = 1u ;
+        for (uint64_t n = _order; n % prime == 0u; n /= prime)
+            target *= prime ;
+        const auto& spectrum = orders();
+        auto members = _normal_closure(generators, {});
+        for (std::size_t size = 1u; size < target; )
+        {
+            auto normalizer = _normalizer(members, generators);
+            for (id_type x = 0; x < _order; ++x)
+            {
+                if (!normalizer.test(x) || spectrum[x] % prime != 0u)
+                    continue ;
+                uint64_t m = spectrum[x];
+                while (m % prime == 0u)
+                    m /= prime ;
+                auto y = _pow(x, static_cast<int64_t>(m));
+                if (members.test(y))
+                    continue ;
+                generators.push_back(y);
+                members = _normal_closure(generators, {});
+                size = members.count();
+                break ;
+            }
+        }
+        return members ;
+    }
+
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::sylow(int64_t prime) const
+    {
+        std::vector<id_type> generators ;
+        return Subgroup<T>{*this, _sylow(prime < 2 ? 0u : static_cast<uint64_t>(prime), generators)};
+    }
+
+    // n_p = |G : N(P)|
+    template <typename T>
+    std::size_t
+    Group<T>::sylow_count(int64_t prime) const
+    {
+        std::vector<id_type> generators ;
+        auto members = _sylow(prime < 2 ? 0u : static_cast<uint64_t>(prime), generators);
+        return _order / _normalizer(members, generators).count();
+    }
+
+    // O_p(G), the largest normal p-subgroup and the core of any Sylow
+    // p-subgroup: P is cut down to P n P^g for the generators g of G
+    // until it no longer moves
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::pcore(int64_t prime) const
+    {
+        std::vector<id_type> generators ;
+        auto core = _sylow(prime < 2 ? 0u : static_cast<uint64_t>(prime), generators);
+        for (bool changed = true; changed; )
+        {
+            changed = false ;
+            for (auto&& g : generating_set())
+            {
+                Bitset next(_order);
+                core.each([&](std::size_t x) {
+                    if (core.test(this->_conj(static_cast<id_type>(x), g)))
+                        next.set(x);
+                });
+                if (next != core)
+                {
+                    core = next ;
+                    changed = true ;
+                }
+            }
+        }
+        return Subgroup<T>{*this, core};
+    }
+
+    // A Hall pi-subgroup grown one prime at a time as H P^g, the conjugates
+    // of a Sylow subgroup P being one per coset of N(P). In a solvable group
+    // every Hall subgroup lies in a larger one for each further prime, so
+    // the search cannot fail there; elsewhere DOES_NOT_EXIST may be thrown
+    // although a Hall subgroup exists.
+    template <typename T>
+    Sub<T, Group>
+    Group<T>::hall(const std::vector<int64_t>& primes) const
+    {
+        std::vector<id_type> generators ;
+        auto members = _normal_closure(generators, {});
+        for (auto&& p : primes)
+        {
+            auto factors = prime_divisors(p < 2 ? 0u : static_cast<uint64_t>(p));
+            if (factors.size() != 1u || factors.front() != static_cast<uint64_t>(p))
+                throw Exception(NOT_CONFORMANT, "Argument is not a prime...");
+            if (_order % static_cast<uint64_t>(p) != 0u)
+                continue ;
+            std::vector<id_type> sylow ;
+            auto part = _sylow(static_cast<uint64_t>(p), sylow);
+            if (part.subset_of(members))
+                continue ;
+            auto target = members.count() * part.count();
+            auto normalizer = _normalizer(part, sylow);
+            Bitset tried(_order);
+            bool found = false ;
+            for (id_type g = 0; g < _order && !found; ++g)
+            {
+                if (tried.test(g))
+                    continue ;
+                normalizer.each([&](std::size_t n) { tried.set(this->_op(static_cast<id_type>(n), g)); });
+                auto candidate = generators ;
+                for (auto&& s : sylow)
+                    candidate.push_back(_conj(s, g));
+                auto closure = _normal_closure(candidate, {});
+                if (closure.count() == target)
+                {
+                    generators = std::move(candidate);
+                    members = std::move(closure);
+                    found = true ;
+                }
+            }
+            if (!found)
+                throw Exception(DOES_NOT_EXIST, "No Hall subgroup for these primes...");
+        }
+        return Subgroup<T>{*this, members};
+    }
+}
+
+#endif
@@ -43,12 +43,6 @@ namespace zebra
         return Pair<B, A>(pair.first, pair.second);
     }
     
-    template <typename A, typename B>
-    bool operator==(const Pair<A, B>& lhs, const Pair<A, B>& rhs)
-    {
-        return lhs.first == rhs.first && lhs.second == rhs.second;
-    }
-    
     template <typename T>
     std::ostream& operator<<(std::ostream& stream, const Set<T>& set)
     {
@@ -414,17 +408,22 @@ namespace zebra
         return result;
     }
 
-    template <typename T, template <typename> class Parent> class Sub : public Parent<T>
+    // The distinct primes dividing n, by trial division
+    inline std::vector<uint64_t> prime_divisors(uint64_t n)
     {
-        using Parent<T>::Parent;
-    public:
-        std::shared_ptr<Parent<T>> parent() const { return _parent; }
-    protected:
-        std::shared_ptr<Parent<T>> _parent ;
-    };
+        std::vector<uint64_t> result ;
+        for (uint64_t d = 2u; d * d <= n; ++d)
+            if (n % d == 0u)
+            {
+                result.push_back(d);
+                while (n % d == 0u)
+                    n /= d ;
+            }
+        if (n > 1u)
+            result.push_back(n);
+        return result ;
+    }
 
-    template <typename T> using Subset = Sub<T, Set>;
-    
 }
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define ZEBRA_EXCEPT
 
 #include <string>
+#include <vector>
 
 namespace zebra
 {
@@ -18,7 +19,8 @@ namespace zebra
         NOT_IN_DOMAIN,
         NOT_CONFORMANT,
         DOES_NOT_EXIST,
-        NOT_A_MEMBER
+        NOT_A_MEMBER,
+        LIMIT_EXCEEDED
     };
 
     std::string ErrorCodesToString(ErrorCodes code)
@@ -31,6 +33,8 @@ namespace zebra
             case NOT_ASSOCIATIVE: return "Operation is not associative...";
             case NO_IDENTITY: return "There exists no identity for the operation...";
             case NO_INVERSE: return "There exists no inverse for some/all elements...";
+            case NOT_CONFORMANT: return "The table is not conformant...";
+            case LIMIT_EXCEEDED: return "A memory or time budget was exceeded...";
             default: return "Unknown error...";
         }
     }
@@ -43,6 +47,7 @@ namespace zebra
         Error(ErrorCodes err) : error_code{err} {}
 
         operator bool() const { return error_code == NO_ERROR; }
+        ErrorCodes code() const { return error_code; }
         
         friend std::ostream& operator<<(std::ostream& stream, Error err)
         {
@@ -51,6 +56,20 @@ namespace zebra
         }
     };
 
+    // An Error that also names the offending elements, e.g. the pair whose
+    // product leaves the set or the triple that breaks associativity
+    template <typename A>
+    class WitnessError : public Error
+    {
+        std::vector<A> elements ;
+
+    public:
+        WitnessError(ErrorCodes err, std::vector<A> witness = {}) 
+            : Error{err}, elements{std::move(witness)} {}
+
+        const std::vector<A>& witness() const { return elements; }
+    };
+
     class Exception
     {
         int error_code;
@@ -1,10 +1,31 @@
 #include "impl/utils.hpp"
+#include "impl/intern.hpp"
+#include "impl/bitset.hpp"
+#include "impl/row.hpp"
+#include "impl/cow.hpp"
+#include "impl/sub.hpp"
+#include "impl/conjugacy.hpp"
 #include "impl/relation.hpp"
 #include "impl/mapping.hpp"
 #include "impl/poset.hpp"
+#include "impl/canonical.hpp"
 #include "impl/binary_operation.hpp"
 #include "impl/magma.hpp"
 #include "impl/semigroup.hpp"
 #include "impl/quasigroup.hpp"
+#include "impl/cayley.hpp"
 #include "impl/monoid.hpp"
-#include "impl/group.hpp"
\ No newline at end of file
+#include "impl/group.hpp"
+#include "impl/lattice.hpp"
+#include "impl/coset.hpp"
+#include "impl/quotient.hpp"
+#include "impl/series.hpp"
+#include "impl/sylow.hpp"
+#include "impl/abelian.hpp"
+#include "impl/permutation.hpp"
+#include "impl/automorphism.hpp"
+#include "impl/random.hpp"
+#include "impl/product.hpp"
+#include "impl/isomorphism.hpp"
+#include "impl/homomorphisms.hpp"
+#include "impl/presentation.hpp"
\ No newline at end of file
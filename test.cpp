@@ -1,5 +1,18 @@
 #include "include/zebra.hpp"
 
+zebra::Group<zebra::Permutation> symmetric_group()
+{
+    using namespace zebra;
+    PermutationGroup s4(4, { Permutation::cycles(4, {{ 0, 1 }}), Permutation::cycles(4, {{ 0, 1, 2, 3 }}) });
+    return s4.to_group();
+}
+
+zebra::Group<zebra::id_type> quaternion_group()
+{
+    using namespace zebra;
+    return CosetEnumeration(Presentation(2, std::vector<std::string>{ "a^4", "a^2B^2", "abaB" })).group();
+}
+
 void relation_testing()
 {
     using namespace zebra;
@@ -46,12 +59,516 @@ void group_testing()
     std::cout << "Group testing... [END]\n\n" << std::endl ;
 }
 
+void interner_testing()
+{
+    using namespace zebra;
+    std::cout << "\nInterner testing... [START]" << std::endl ;
+    Interner<std::string> symbols(Set<std::string>({ "x", "y", "z" }));
+    std::cout << "Interner over " << symbols.size() << " values..." << std::endl;
+    auto id = symbols.intern("w");
+    std::cout << "Id of a new value : " << id << std::endl ;
+    std::cout << "Interning it again gives the same id ? " << (symbols.intern("w") == id) << std::endl ;
+    std::cout << "Value back from its id : " << symbols[id] << std::endl ;
+    std::cout << "Unknown value found ? " << (symbols.find("v") != npos) << std::endl ;
+    std::cout << "Interner testing... [END]\n\n" << std::endl ;
+}
+
+void row_testing()
+{
+    using namespace zebra;
+    std::cout << "\nRow testing... [START]" << std::endl ;
+    Row row ;
+    std::cout << "Row grown from one id to a dense run..." << std::endl;
+    row.insert(7);
+    std::cout << "Size with one id : " << row.size() << std::endl ;
+    for (id_type x = 40; x > 0; x -= 4)
+        row.insert(x);
+    std::cout << "Size with sparse ids : " << row.size() << std::endl ;
+    for (id_type x = 0; x < 64; ++x)
+        row.insert(x);
+    std::cout << "Size with a dense run : " << row.size() << std::endl ;
+    bool ascending = true ;
+    id_type previous = 0 ;
+    for (auto x = row.begin(); x != row.end(); ++x)
+    {
+        ascending = ascending && (x == row.begin() || *x > previous);
+        previous = *x ;
+    }
+    std::cout << "Is iteration ascending ? " << ascending << std::endl ;
+    row.erase(7);
+    std::cout << "Contains 7 after erasing it ? " << (row.count(7) > 0) << std::endl ;
+    Row copy(row);
+    std::cout << "Copy equals the row ? " << (copy == row) << std::endl ;
+    std::cout << "Bytes per row : " << sizeof(Row) << std::endl ;
+    std::cout << "Row testing... [END]\n\n" << std::endl ;
+}
+
+void cow_testing()
+{
+    using namespace zebra;
+    std::cout << "\nCopy on write testing... [START]" << std::endl ;
+    Cow<std::vector<int>> first(std::vector<int>({ 1, 2, 3 }));
+    auto second = first ;
+    std::cout << "Copy shares the storage ? " << second.shares(first) << std::endl ;
+    second.write().push_back(4);
+    std::cout << "Shares after a write ? " << second.shares(first) << std::endl ;
+    std::cout << "Sizes : " << first->size() << " and " << second->size() << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4 });
+    Group<int> group([](int x, int y){ return (x + y) % 5; }, set);
+    auto copy = group ;
+    std::cout << "Group copy shares its table ? " << (&copy.cells() == &group.cells()) << std::endl ;
+    std::cout << "Copy on write testing... [END]\n\n" << std::endl ;
+}
+
+void sub_testing()
+{
+    using namespace zebra;
+    std::cout << "\nSubgroup view testing... [START]" << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+    std::cout << "View {0, 4, 8} of the modulo-12 addition group..." << std::endl;
+    Group<int> group([](int x, int y){ return (x + y) % 12; }, set);
+    Subgroup<int> view{group, Set<int>({ 0, 4, 8 })};
+    std::cout << "Size : " << view.size() << std::endl ;
+    std::cout << "Is closed ? " << view.closed() << std::endl ;
+    std::cout << "Contains 6 ? " << view.contains(6) << std::endl ;
+    std::cout << "Product of 4 and 8 : " << view.at(4, 8) << std::endl ;
+    std::cout << "Is closed {0, 5} ? " << Subgroup<int>{group, Set<int>({ 0, 5 })}.closed() << std::endl ;
+    std::cout << "Order once materialized : " << view.materialize().order() << std::endl ;
+    std::cout << "Subgroup view testing... [END]\n\n" << std::endl ;
+}
+
+void is_group_testing()
+{
+    using namespace zebra;
+    std::cout << "\nGroup check testing... [START]" << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4 });
+    std::cout << "Operations on " << set << "..." << std::endl;
+    auto sum = is_group(set, [](int x, int y){ return (x + y) % 5; });
+    std::cout << "Modulo-5 addition : " << sum << std::endl ;
+    auto product = is_group(set, [](int x, int y){ return (x * y) % 5; });
+    std::cout << "Modulo-5 multiplication : " << product ;
+    for (auto&& x : product.witness())
+        std::cout << " " << x ;
+    std::cout << std::endl ;
+    auto difference = is_group(set, [](int x, int y){ return (x + 5 - y) % 5; });
+    std::cout << "Modulo-5 subtraction : " << difference ;
+    for (auto&& x : difference.witness())
+        std::cout << " " << x ;
+    std::cout << std::endl ;
+    auto projection = is_group(set, [](int, int y){ return y; });
+    std::cout << "Right projection : " << projection << std::endl ;
+    auto plain = is_group(set, [](int x, int y){ return x + y; });
+    std::cout << "Plain addition : " << plain ;
+    for (auto&& x : plain.witness())
+        std::cout << " " << x ;
+    std::cout << std::endl ;
+    int loop[5][5] = { { 0, 1, 2, 3, 4 }, { 1, 0, 3, 4, 2 }, { 2, 4, 0, 1, 3 }, { 3, 2, 4, 0, 1 }, { 4, 3, 1, 2, 0 } };
+    auto latin = is_group(set, [&loop](int x, int y){ return loop[x][y]; });
+    std::cout << "Loop of order 5 : " << latin ;
+    for (auto&& x : latin.witness())
+        std::cout << " " << x ;
+    std::cout << std::endl ;
+    std::cout << "Group check testing... [END]\n\n" << std::endl ;
+}
+
+void permutation_testing()
+{
+    using namespace zebra;
+    std::cout << "\nPermutation group testing... [START]" << std::endl ;
+    std::vector<id_type> cycle(10);
+    for (id_type x = 0; x < 10; ++x)
+        cycle[x] = (x + 1) % 10 ;
+    PermutationGroup group(10, { Permutation::cycles(10, {{ 0, 1 }}), Permutation(cycle) });
+    std::cout << "Group generated by (0 1) and " << Permutation(cycle) << std::endl;
+    std::cout << "Order : " << group.order() << std::endl ;
+    std::cout << "Base length : " << group.base().size() << std::endl ;
+    std::cout << "Contains (2 5 7) ? " << group.contains(Permutation::cycles(10, {{ 2, 5, 7 }})) << std::endl ;
+    std::cout << "Order of the stabiliser of 0 : " << group.point_stabilizer(0).order() << std::endl ;
+    std::cout << "Permutation group testing... [END]\n\n" << std::endl ;
+}
+
+void lattice_testing()
+{
+    using namespace zebra;
+    std::cout << "\nSubgroup lattice testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    auto lattice = group.lattice();
+    std::cout << "Number of subgroups : " << lattice.size() << std::endl ;
+    std::cout << "Number of normal subgroups : " << lattice.normal().size() << std::endl ;
+    std::cout << "Number of maximal subgroups : " << lattice.maximal().size() << std::endl ;
+    std::cout << "Is a partial order ? " << lattice.relation().partial_order() << std::endl ;
+    std::cout << "Is simple ? " << group.simple() << std::endl ;
+    std::cout << "Subgroup lattice testing... [END]\n\n" << std::endl ;
+}
+
+void conjugacy_testing()
+{
+    using namespace zebra;
+    std::cout << "\nConjugacy testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    std::cout << "Number of classes : " << group.conjugacy_classes().size() << std::endl ;
+    std::cout << "Size of the class of (0 1) : " << group.conjugacy_class(Permutation::cycles(4, {{ 0, 1 }})).size() << std::endl ;
+    std::cout << "Are (0 1) and (2 3) conjugate ? " << group.conjugate(Permutation::cycles(4, {{ 0, 1 }}), Permutation::cycles(4, {{ 2, 3 }})) << std::endl ;
+    std::cout << "Order of the centralizer of (0 1 2 3) : " << group.centralizer(Permutation::cycles(4, {{ 0, 1, 2, 3 }})).size() << std::endl ;
+    std::cout << "Order of the center : " << group.center().size() << std::endl ;
+    std::cout << "Conjugacy testing... [END]\n\n" << std::endl ;
+}
+
+void division_testing()
+{
+    using namespace zebra;
+    std::cout << "\nDivision testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    auto x = Permutation::cycles(4, {{ 0, 1, 2, 3 }}), y = Permutation::cycles(4, {{ 0, 2 }});
+    std::cout << "Inverse of " << x << " : " << group.inverse(x) << std::endl ;
+    std::cout << "x (x \\ y) is y ? " << (group.at(x, group.left_divide(x, y)) == y) << std::endl ;
+    std::cout << "(x / y) y is x ? " << (group.at(group.right_divide(x, y), y) == x) << std::endl ;
+    std::cout << "Division testing... [END]\n\n" << std::endl ;
+}
+
+void power_testing()
+{
+    using namespace zebra;
+    std::cout << "\nPower testing... [START]" << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+    std::cout << "Group with set: " << set << " and operation: modulo-12 addition..." << std::endl;
+    Group<int> group([](int x, int y){ return (x + y) % 12; }, set);
+    std::cout << "5 to the power -1 : " << group.pow(5, -1) << std::endl ;
+    std::cout << "5 to the power -7 : " << group.pow(5, -7) << std::endl ;
+    std::cout << "Order of 8 : " << group.order(8) << std::endl ;
+    std::cout << "Exponent : " << group.exponent() << std::endl ;
+    std::cout << "Elements of order 12 : " << group.order_histogram()[12] << std::endl ;
+    std::cout << "Is cyclic ? " << group.cyclic() << std::endl ;
+    std::cout << "Is a 2-group ? " << group.pgroup(2) << std::endl ;
+    std::cout << "Exponent of S4 : " << symmetric_group().exponent() << std::endl ;
+    std::cout << "Is S4 cyclic ? " << symmetric_group().cyclic() << std::endl ;
+    std::cout << "5 to the power INT64_MIN : " << group.pow(5, std::numeric_limits<int64_t>::min()) << std::endl ;
+    Set<int> sixteen ;
+    for (int x = 0; x < 16; ++x)
+        sixteen.insert(x);
+    Group<int> z16([](int x, int y){ return (x + y) % 16; }, sixteen);
+    std::cout << "Is Z16 a 2-group ? " << z16.pgroup(2) << std::endl ;
+    std::cout << "Is Z16 a 4-group ? " << z16.pgroup(4) << std::endl ;
+    std::cout << "Power testing... [END]\n\n" << std::endl ;
+}
+
+void product_testing()
+{
+    using namespace zebra;
+    std::cout << "\nSemidirect product testing... [START]" << std::endl ;
+    Set<int> three({ 0, 1, 2 }), two({ 0, 1 });
+    Group<int> z3([](int x, int y){ return (x + y) % 3; }, three);
+    Group<int> z2([](int x, int y){ return (x + y) % 2; }, two);
+    std::cout << "Z3 by Z2 acting through inversion..." << std::endl;
+    SemidirectProduct<int, int> product(z3, z2, [](int h, int n){ return h ? (3 - n) % 3 : n; });
+    std::cout << "Order : " << product.order() << std::endl ;
+    std::cout << "Is direct ? " << product.direct() << std::endl ;
+    std::cout << "Order of (1, 0) : " << product.order(std::make_pair(1, 0)) << std::endl ;
+    std::cout << "Order of (1, 1) : " << product.order(std::make_pair(1, 1)) << std::endl ;
+    auto table = product.materialize();
+    std::cout << "Is abelian ? " << table.commutative() << std::endl ;
+    std::cout << "Number of classes : " << table.conjugacy().classes() << std::endl ;
+    std::cout << "Is Z3 x Z2 abelian ? " << (z3 * z2).commutative() << std::endl ;
+    std::cout << "(1, 1) to the power INT64_MIN : " << product.pow(std::make_pair(1, 1), std::numeric_limits<int64_t>::min()).first << std::endl ;
+    std::cout << "Semidirect product testing... [END]\n\n" << std::endl ;
+}
+
+void quotient_testing()
+{
+    using namespace zebra;
+    std::cout << "\nQuotient group testing... [START]" << std::endl ;
+    std::cout << "Group S4 by the Klein four group..." << std::endl;
+    auto group = symmetric_group();
+    Subgroup<Permutation> klein{group, Set<Permutation>({ Permutation(4),
+        Permutation::cycles(4, {{ 0, 1 }, { 2, 3 }}), Permutation::cycles(4, {{ 0, 2 }, { 1, 3 }}),
+        Permutation::cycles(4, {{ 0, 3 }, { 1, 2 }}) })};
+    auto quotient = group / klein ;
+    std::cout << "Order : " << quotient.order() << std::endl ;
+    std::cout << "Is abelian ? " << quotient.commutative() << std::endl ;
+    std::cout << "Is projection a function ? " << quotient.projection().function() << std::endl ;
+    std::cout << "Quotient group testing... [END]\n\n" << std::endl ;
+}
+
+void coset_testing()
+{
+    using namespace zebra;
+    std::cout << "\nCoset testing... [START]" << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+    std::cout << "Group with set: " << set << " and operation: modulo-12 addition..." << std::endl;
+    Group<int> group([](int x, int y){ return (x + y) % 12; }, set);
+    auto cosets = group.cosets(Set<int>({ 0, 4, 8 }));
+    std::cout << "Index of {0, 4, 8} : " << cosets.index() << std::endl ;
+    std::cout << "Is normal ? " << cosets.normal() << std::endl ;
+    std::cout << "Same coset 1 and 9 ? " << cosets.same_left(1, 9) << std::endl ;
+    std::cout << "Representative of 10 in its coset ? " << cosets.same_left(cosets.left_representative(10), 10) << std::endl ;
+    std::cout << "Order of the quotient : " << (group / Subgroup<int>{group, Set<int>({ 0, 4, 8 })}).order() << std::endl ;
+    for (auto&& bad : { Set<int>({ 0, 11 }), Set<int>({ 0, 4, 5 }), Set<int>({ 0, 13 }) })
+        try {
+            group.cosets(bad);
+            std::cout << "Cosets of " << bad << " accepted" << std::endl ;
+        }
+        catch (const Exception& exp) {
+            std::cout << "Cosets of " << bad << " rejected : " << exp.what() << std::endl ;
+        }
+    try {
+        group.quotient(Subgroup<int>{group, Set<int>({ 0, 11 })});
+        std::cout << "Quotient by {0, 11} accepted" << std::endl ;
+    }
+    catch (const Exception& exp) {
+        std::cout << "Quotient by {0, 11} rejected : " << exp.what() << std::endl ;
+    }
+    std::cout << "Coset testing... [END]\n\n" << std::endl ;
+}
+
+void closure_testing()
+{
+    using namespace zebra;
+    std::cout << "\nClosure testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    auto cyclic = group.generate({ Permutation::cycles(4, {{ 0, 1, 2, 3 }}) });
+    std::cout << "Order of <(0 1 2 3)> : " << cyclic.size() << std::endl ;
+    auto closure = group.generate({ Permutation::cycles(4, {{ 0, 1 }}), Permutation::cycles(4, {{ 1, 2 }}) });
+    std::cout << "Order of <(0 1), (1 2)> : " << closure.size() << std::endl ;
+    auto target = Permutation::cycles(4, {{ 0, 2 }});
+    auto word = closure.word(target);
+    std::cout << "Length of the word for (0 2) : " << word.size() << std::endl ;
+    std::cout << "Word evaluates back ? " << (closure.evaluate(word) == target) << std::endl ;
+    std::cout << "Closure testing... [END]\n\n" << std::endl ;
+}
+
+void morphism_testing()
+{
+    using namespace zebra;
+    std::cout << "\nGroup homomorphism testing... [START]" << std::endl ;
+    Set<int> two({ 0, 1 });
+    Group<int> z2([](int x, int y){ return (x + y) % 2; }, two);
+    std::cout << "Sign of S4 given on (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    std::vector<Permutation> generators({ Permutation::cycles(4, {{ 0, 1 }}), Permutation::cycles(4, {{ 0, 1, 2, 3 }}) });
+    GroupHomomorphism<Permutation, int> sign(group, z2, generators, { 1, 1 });
+    std::cout << "Order of the kernel : " << sign.kernel().size() << std::endl ;
+    std::cout << "Order of the image : " << sign.image().size() << std::endl ;
+    std::cout << "Is epimorphism ? " << sign.epimorphism() << std::endl ;
+    try {
+        GroupHomomorphism<Permutation, int> bad(group, z2, generators, { 0, 1 });
+        std::cout << "Images 0 and 1 accepted" << std::endl ;
+    }
+    catch (const Exception& exp) {
+        std::cout << "Images 0 and 1 rejected : " << exp.what() << std::endl ;
+    }
+    std::cout << "Group homomorphism testing... [END]\n\n" << std::endl ;
+}
+
+void presentation_testing()
+{
+    using namespace zebra;
+    std::cout << "\nCoset enumeration testing... [START]" << std::endl ;
+    Presentation dihedral(2, std::vector<std::string>{ "a^6", "b^2", "abab" });
+    std::cout << "Presentation <a, b | a^6, b^2, abab>..." << std::endl;
+    std::cout << "Order : " << CosetEnumeration(dihedral).index() << std::endl ;
+    std::cout << "Index of <b> : " << CosetEnumeration(dihedral, { Presentation::parse("b") }).index() << std::endl ;
+    Presentation simple(2, { Presentation::parse("a^2"), Presentation::parse("b^3"),
+                             Presentation::power(Presentation::parse("ab"), 7),
+                             Presentation::power(Presentation::parse("abAB"), 4) });
+    std::cout << "Presentation <a, b | a^2, b^3, (ab)^7, [a, b]^4>..." << std::endl;
+    CosetEnumeration enumeration(simple);
+    std::cout << "Order : " << enumeration.index() << std::endl ;
+    std::cout << "Is simple ? " << enumeration.group().simple() << std::endl ;
+    std::cout << "Coset enumeration testing... [END]\n\n" << std::endl ;
+}
+
+void isomorphism_testing()
+{
+    using namespace zebra;
+    std::cout << "\nIsomorphism testing... [START]" << std::endl ;
+    auto quaternion = quaternion_group();
+    auto dihedral = CosetEnumeration(Presentation(2, std::vector<std::string>{ "a^4", "b^2", "abab" })).group();
+    std::cout << "Quaternion and dihedral groups of order 8..." << std::endl;
+    std::cout << "Are isomorphic ? " << isomorphic(quaternion, dihedral) << std::endl ;
+    Set<int> six({ 0, 1, 2, 3, 4, 5 }), two({ 0, 1 }), three({ 0, 1, 2 });
+    Group<int> z6([](int x, int y){ return (x + y) % 6; }, six);
+    Group<int> z2([](int x, int y){ return (x + y) % 2; }, two);
+    Group<int> z3([](int x, int y){ return (x + y) % 3; }, three);
+    std::cout << "Z6 and Z2 x Z3 are isomorphic ? " << isomorphic(z6, z2 * z3) << std::endl ;
+    std::cout << "Isomorphism is a bijection ? " << isomorphism(z6, z2 * z3).bijection() << std::endl ;
+    std::cout << "Isomorphism testing... [END]\n\n" << std::endl ;
+}
+
+void canonical_testing()
+{
+    using namespace zebra;
+    std::cout << "\nCanonical form testing... [START]" << std::endl ;
+    PermutationGroup s3(3, { Permutation::cycles(3, {{ 0, 1 }}), Permutation::cycles(3, {{ 0, 1, 2 }}) });
+    auto permutations = s3.to_group();
+    auto presented = CosetEnumeration(Presentation(2, std::vector<std::string>{ "a^3", "b^2", "abab" })).group();
+    Set<int> set({ 0, 1, 2, 3, 4, 5 });
+    Group<int> cyclic([](int x, int y){ return (x + y) % 6; }, set);
+    std::cout << "S3 as permutations, S3 from a presentation and Z6..." << std::endl;
+    std::cout << "Same fingerprint for both S3 ? " << (permutations.fingerprint() == presented.fingerprint()) << std::endl ;
+    std::cout << "Same fingerprint for S3 and Z6 ? " << (permutations.fingerprint() == cyclic.fingerprint()) << std::endl ;
+    std::cout << "Same canonical table for both S3 ? " << (permutations.canonical().cells() == presented.canonical().cells()) << std::endl ;
+    std::cout << "Canonical form testing... [END]\n\n" << std::endl ;
+}
+
+void automorphism_testing()
+{
+    using namespace zebra;
+    std::cout << "\nAutomorphism testing... [START]" << std::endl ;
+    std::cout << "Quaternion group of order 8..." << std::endl;
+    std::cout << "Order of the automorphism group : " << quaternion_group().automorphisms().order() << std::endl ;
+    Set<int> set({ 0, 1, 2, 3, 4, 5, 6, 7 });
+    Group<int> cyclic([](int x, int y){ return (x + y) % 8; }, set);
+    std::cout << "Order of the automorphism group of Z8 : " << cyclic.automorphisms().order() << std::endl ;
+    std::cout << "Automorphism testing... [END]\n\n" << std::endl ;
+}
+
+void series_testing()
+{
+    using namespace zebra;
+    std::cout << "\nSeries testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    std::cout << "Derived series orders :" ;
+    for (auto&& term : group.derived_series())
+        std::cout << " " << term.size() ;
+    std::cout << std::endl ;
+    std::cout << "Is solvable ? " << group.solvable() << std::endl ;
+    std::cout << "Is nilpotent ? " << group.nilpotent() << std::endl ;
+    std::cout << "Derived length : " << group.derived_length() << std::endl ;
+    auto dihedral = CosetEnumeration(Presentation(2, std::vector<std::string>{ "a^8", "b^2", "abab" })).group();
+    std::cout << "Nilpotency class of the dihedral group of order 16 : " << dihedral.nilpotency_class() << std::endl ;
+    std::cout << "Series testing... [END]\n\n" << std::endl ;
+}
+
+void sylow_testing()
+{
+    using namespace zebra;
+    std::cout << "\nSylow testing... [START]" << std::endl ;
+    std::cout << "Group S4 generated by (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    std::cout << "Order of a Sylow 2-subgroup : " << group.sylow(2).size() << std::endl ;
+    std::cout << "Number of Sylow 2-subgroups : " << group.sylow_count(2) << std::endl ;
+    std::cout << "Number of Sylow 3-subgroups : " << group.sylow_count(3) << std::endl ;
+    std::cout << "Order of the 2-core : " << group.pcore(2).size() << std::endl ;
+    std::cout << "Order of the normalizer of a Sylow 3-subgroup : " << group.normalizer(group.sylow(3)).size() << std::endl ;
+    auto alternating = CosetEnumeration(Presentation(2, std::vector<std::string>{ "a^2", "b^3", "ababababab" })).group();
+    std::cout << "Number of Sylow 5-subgroups of A5 : " << alternating.sylow_count(5) << std::endl ;
+    std::cout << "Order of a Hall {2, 3}-subgroup of A5 : " << alternating.hall({ 2, 3 }).size() << std::endl ;
+    std::cout << "Sylow testing... [END]\n\n" << std::endl ;
+}
+
+void abelian_testing()
+{
+    using namespace zebra;
+    std::cout << "\nAbelian group testing... [START]" << std::endl ;
+    Set<int> set ;
+    for (int x = 0; x < 24; ++x)
+        set.insert(x);
+    std::cout << "Group Z4 x Z6 as pairs packed in 0..23..." << std::endl;
+    AbelianGroup<int> group([](int x, int y){ return (x % 4 + y % 4) % 4 + 4 * ((x / 4 + y / 4) % 6); }, set);
+    std::cout << "Invariant factors :" ;
+    for (auto&& d : group.invariant_factors())
+        std::cout << " " << d ;
+    std::cout << std::endl ;
+    std::cout << "Primary decomposition :" ;
+    for (auto&& q : group.primary_decomposition())
+        std::cout << " " << q ;
+    std::cout << std::endl ;
+    Subgroup<int> left{group, Set<int>({ 0, 1, 2, 3 })}, right{group, Set<int>({ 0, 4, 8, 12, 16, 20 })};
+    std::cout << "Is a direct sum of Z4 and Z6 ? " << group.direct_sum(left.materialize(), right.materialize()) << std::endl ;
+    std::cout << "Abelian group testing... [END]\n\n" << std::endl ;
+}
+
+void cayley_testing()
+{
+    using namespace zebra;
+    std::cout << "\nCayley graph testing... [START]" << std::endl ;
+    std::cout << "Group S4 with generators (0 1) and (0 1 2 3)..." << std::endl;
+    auto group = symmetric_group();
+    auto graph = group.cayley_graph({ Permutation::cycles(4, {{ 0, 1 }}), Permutation::cycles(4, {{ 0, 1, 2, 3 }}) });
+    std::cout << "Diameter : " << graph.diameter() << std::endl ;
+    std::cout << "Growth :" ;
+    for (auto&& n : graph.growth())
+        std::cout << " " << n ;
+    std::cout << std::endl ;
+    auto target = Permutation::cycles(4, {{ 0, 3 }});
+    std::cout << "Length of (0 3) : " << graph.length(target) << std::endl ;
+    std::cout << "Word evaluates back ? " << (graph.evaluate(graph.word(target)) == target) << std::endl ;
+    std::cout << "Cayley graph testing... [END]\n\n" << std::endl ;
+}
+
+void random_testing()
+{
+    using namespace zebra;
+    std::cout << "\nProduct replacement testing... [START]" << std::endl ;
+    PermutationGroup s5(5, { Permutation::cycles(5, {{ 0, 1 }}), Permutation::cycles(5, {{ 0, 1, 2, 3, 4 }}) });
+    std::cout << "Group S5 sampled with seed 7..." << std::endl;
+    auto first = product_replacement(s5, 7u), second = product_replacement(s5, 7u);
+    std::cout << "Same sequence for the same seed ? " << (first.batch(20) == second.batch(20)) << std::endl ;
+    auto estimate = first.commuting_probability(4000);
+    std::cout << "Commuting probability near 7 / 120 ? " << (estimate > 0.04 && estimate < 0.08) << std::endl ;
+    std::cout << "Product replacement testing... [END]\n\n" << std::endl ;
+}
+
+void homomorphism_testing()
+{
+    using namespace zebra;
+    std::cout << "\nHomomorphism testing... [START]" << std::endl ;
+    auto group = symmetric_group();
+    std::cout << "Number of endomorphisms of S4 : " << count_homomorphisms(group, group) << std::endl ;
+    Set<int> twelve, eighteen ;
+    for (int x = 0; x < 18; ++x)
+    {
+        if (x < 12)
+            twelve.insert(x);
+        eighteen.insert(x);
+    }
+    Group<int> z12([](int x, int y){ return (x + y) % 12; }, twelve);
+    Group<int> z18([](int x, int y){ return (x + y) % 18; }, eighteen);
+    auto maps = homomorphisms(z12, z18);
+    std::cout << "Number of homomorphisms from Z12 to Z18 : " << maps.size() << std::endl ;
+    bool all = true ;
+    for (auto&& map : maps)
+        all = all && is_homomorphism(z12, z18, map);
+    std::cout << "Are all homomorphisms ? " << all << std::endl ;
+    std::cout << "Homomorphism testing... [END]\n\n" << std::endl ;
+}
+
 int main()
 {
     std::cout << std::boolalpha ;
     try {
         relation_testing();
         group_testing();
+        interner_testing();
+        row_testing();
+        cow_testing();
+        sub_testing();
+        is_group_testing();
+        permutation_testing();
+        lattice_testing();
+        conjugacy_testing();
+        division_testing();
+        power_testing();
+        product_testing();
+        quotient_testing();
+        coset_testing();
+        closure_testing();
+        morphism_testing();
+        presentation_testing();
+        isomorphism_testing();
+        canonical_testing();
+        automorphism_testing();
+        series_testing();
+        sylow_testing();
+        abelian_testing();
+        cayley_testing();
+        random_testing();
+        homomorphism_testing();
     } 
     catch (const zebra::Exception& exp)
     {